@@ -36,35 +36,43 @@ uint8_t SSC::stop() {
   return setError(NoError);
 }
 
-uint8_t SSC::update() {
+uint8_t SSC::update(uint8_t attempts) {
+  uint8_t result = StaleDataError;
+  while (attempts-- && result == StaleDataError) {
+    result = poll();
+  }
+  return result;
+}
+
+uint8_t SSC::poll() {
   uint8_t x, y, s;
 
-  while (1) {
-    Wire.requestFrom(a, (uint8_t)4);
-    if (Wire.available()) {
+  Wire.requestFrom(a, (uint8_t)4);
+  if (!Wire.available()) {
+    return setError(CommunicationError);
+  }
+
+  x = Wire.read();
+  y = Wire.read();
+  s = x >> 6;
+
+  switch (s) {
+    case 0:
+      p = (((uint16_t)(x & 0x3f)) << 8) | y;
       x = Wire.read();
       y = Wire.read();
-      s = x >> 6;
-
-      switch (s) {
-        case 0:
-          p = (((uint16_t)(x & 0x3f)) << 8) | y;
-          x = Wire.read();
-          y = Wire.read();
-          t = ((((uint16_t)x) << 8) | y) >> 5;
-          Wire.endTransmission();
-          return setError(NoError);
-        case 2:
-          Wire.endTransmission();
-          break;
-        case 1:
-          Wire.endTransmission();
-          return setError(CommandModeError);
-        case 3:
-          Wire.endTransmission();
-          return setError(DiagnosticError);
-      }
-    }
+      t = ((((uint16_t)x) << 8) | y) >> 5;
+      Wire.endTransmission();
+      return setError(NoError);
+    case 1:
+      Wire.endTransmission();
+      return setError(CommandModeError);
+    case 2:
+      Wire.endTransmission();
+      return setError(StaleDataError);
+    default:
+      Wire.endTransmission();
+      return setError(DiagnosticError);
   }
 }
 
@@ -19,6 +19,7 @@ class SSC
     NotRunningError         = 3,
     DiagnosticError         = 4,
     CommandModeError        = 5,
+    StaleDataError          = 6,
     ErrorMask               = 15
   };
   
@@ -64,8 +65,12 @@ class SSC
   uint8_t start();
   uint8_t stop();
   
-  //  update pressure and temperature
-  uint8_t update();
+  //  update pressure and temperature, retrying up to `attempts` times while the
+  //  sensor reports stale data
+  uint8_t update(uint8_t attempts = 10);
+
+  //  single read, returns StaleDataError if the sensor has no new measurement yet
+  uint8_t poll();
 
   //  convert pressure and temperature
   float rawToPressure(uint16_t raw) const { return rawToPressure(raw, rmin, rmax, pmin, pmax); }
@@ -43,7 +43,6 @@
 #define CMD_ADC_4096 0x08  // ADC resolution=4096
 
 // Create array to hold the 8 sensor calibration coefficients
-static unsigned int sensorCoeffs[8];  // unsigned 16-bit integer (0-65535)
 // D1 and D2 need to be unsigned 32-bit integers (long 0-4294967295)
 static uint32_t D1 = 0;  // Store uncompensated pressure value
 static uint32_t D2 = 0;  // Store uncompensated temperature value
@@ -71,7 +70,10 @@ MS_5803::MS_5803(byte i2c_address, uint16_t Resolution) {
 
     // The argument is the oversampling resolution, which may have values
     // of 256, 512, 1024, 2048, or 4096.
-    _Resolution = Resolution;
+    _Resolution     = Resolution;
+    conversion      = IDLE;
+    conversionStart = 0;
+    conversionTime  = 0;
 }
 
 //-------------------------------------------------
@@ -139,22 +141,83 @@ void MS_5803::readSensor() {
     // Choose from CMD_ADC_256, 512, 1024, 2048, 4096 for mbar resolutions
     // of 1, 0.6, 0.4, 0.3, 0.2 respectively. Higher resolutions take longer
     // to read.
-    if (_Resolution == 256) {
-        D1 = MS_5803_ADC(CMD_ADC_D1 + CMD_ADC_256);  // read raw pressure
-        D2 = MS_5803_ADC(CMD_ADC_D2 + CMD_ADC_256);  // read raw temperature
-    } else if (_Resolution == 512) {
-        D1 = MS_5803_ADC(CMD_ADC_D1 + CMD_ADC_512);  // read raw pressure
-        D2 = MS_5803_ADC(CMD_ADC_D2 + CMD_ADC_512);  // read raw temperature
-    } else if (_Resolution == 1024) {
-        D1 = MS_5803_ADC(CMD_ADC_D1 + CMD_ADC_1024);  // read raw pressure
-        D2 = MS_5803_ADC(CMD_ADC_D2 + CMD_ADC_1024);  // read raw temperature
-    } else if (_Resolution == 2048) {
-        D1 = MS_5803_ADC(CMD_ADC_D1 + CMD_ADC_2048);  // read raw pressure
-        D2 = MS_5803_ADC(CMD_ADC_D2 + CMD_ADC_2048);  // read raw temperature
-    } else if (_Resolution == 4096) {
-        D1 = MS_5803_ADC(CMD_ADC_D1 + CMD_ADC_4096);  // read raw pressure
-        D2 = MS_5803_ADC(CMD_ADC_D2 + CMD_ADC_4096);  // read raw temperature
+    conversion = IDLE;
+    D1         = MS_5803_ADC(CMD_ADC_D1 + resolutionCommand());  // read raw pressure
+    D2         = MS_5803_ADC(CMD_ADC_D2 + resolutionCommand());  // read raw temperature
+    calculate();
+}
+
+//------------------------------------------------------------------
+// Same as readSensor() but returns instead of waiting for a conversion.
+// Call it until it returns true, at most every conversionMicros().
+boolean MS_5803::poll() {
+    switch (conversion) {
+    case IDLE:
+        startConversion(CMD_ADC_D1 + resolutionCommand());
+        conversion = CONVERTING_D1;
+        return false;
+    case CONVERTING_D1:
+        if ((unsigned long) (micros() - conversionStart) < conversionTime) {
+            return false;
+        }
+
+        D1 = readADC();  // raw pressure
+        startConversion(CMD_ADC_D2 + resolutionCommand());
+        conversion = CONVERTING_D2;
+        return false;
+    case CONVERTING_D2:
+        if ((unsigned long) (micros() - conversionStart) < conversionTime) {
+            return false;
+        }
+
+        D2         = readADC();  // raw temperature
+        conversion = IDLE;
+        calculate();
+        return true;
+    }
+
+    return false;
+}
+
+//------------------------------------------------------------------
+char MS_5803::resolutionCommand() const {
+    switch (_Resolution) {
+    case 256:
+        return CMD_ADC_256;
+    case 1024:
+        return CMD_ADC_1024;
+    case 2048:
+        return CMD_ADC_2048;
+    case 4096:
+        return CMD_ADC_4096;
+    default:
+        return CMD_ADC_512;
+    }
+}
+
+//------------------------------------------------------------------
+// Maximum conversion times from the data sheet
+unsigned long MS_5803::conversionMicros(char resolutionCommand) {
+    switch (resolutionCommand) {
+    case CMD_ADC_256:
+        return 600;
+    case CMD_ADC_1024:
+        return 2280;
+    case CMD_ADC_2048:
+        return 4540;
+    case CMD_ADC_4096:
+        return 9040;
+    default:
+        return 1170;
     }
+}
+
+unsigned long MS_5803::conversionMicros() const {
+    return conversionMicros(resolutionCommand());
+}
+
+//------------------------------------------------------------------
+void MS_5803::calculate() {
     // Calculate 1st order temperature, dT is a long integer
     // D2 is originally cast as an uint32_t, but can fit in a int32_t, so we'll
     // cast both parts of the equation below as signed values so that we can
@@ -267,13 +330,8 @@ unsigned char MS_5803::MS_5803_CRC(unsigned int n_prom[]) {
 //-----------------------------------------------------------------
 // Send commands and read the temperature and pressure from the sensor
 unsigned long MS_5803::MS_5803_ADC(char commandADC) {
-    // D1 and D2 will come back as 24-bit values, and so they must be stored in
-    // a long integer on 8-bit Arduinos.
-    long result = 0;
     // Send the command to do the ADC conversion on the chip
-    Wire.beginTransmission(i2c_address);
-    Wire.write(CMD_ADC_CONV + commandADC);
-    Wire.endTransmission();
+    startConversion(commandADC);
     // Wait a specified period of time for the ADC conversion to happen
     // See table on page 1 of the MS5803 data sheet showing response times of
     // 0.5, 1.1, 2.1, 4.1, 8.22 ms for each accuracy level.
@@ -294,6 +352,22 @@ unsigned long MS_5803::MS_5803_ADC(char commandADC) {
         delay(10);
         break;
     }
+    return readADC();
+}
+
+void MS_5803::startConversion(char commandADC) {
+    Wire.beginTransmission(i2c_address);
+    Wire.write(CMD_ADC_CONV + commandADC);
+    Wire.endTransmission();
+    // Kept per conversion so that setResolution() during one does not cut it short
+    conversionStart = micros();
+    conversionTime  = conversionMicros(commandADC & 0x0F);
+}
+
+unsigned long MS_5803::readADC() {
+    // D1 and D2 will come back as 24-bit values, and so they must be stored in
+    // a long integer on 8-bit Arduinos.
+    long result = 0;
     // Now send the read command to the MS5803
     Wire.beginTransmission(i2c_address);
     Wire.write((byte) CMD_ADC_READ);
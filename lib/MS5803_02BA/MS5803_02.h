@@ -40,8 +40,20 @@ public:
     boolean initializeMS_5803(boolean Verbose = true);
     // Reset the sensor
     void resetSensor();
-    // Read the sensor
+    // Read the sensor. Blocks for both conversions.
     void readSensor();
+    // Non-blocking read. Starts the pressure conversion, then the temperature
+    // conversion, each on a later call once the previous one is done. Returns
+    // true on the call that completes a reading.
+    boolean poll();
+    // True while a conversion started by poll() is in progress
+    boolean isConverting() const    {return conversion != IDLE;}
+    // Change the oversampling resolution (256, 512, 1024, 2048, 4096).
+    // Applies from the next conversion.
+    void setResolution(uint16_t Resolution) {_Resolution = Resolution;}
+    uint16_t resolution() const     {return _Resolution;}
+    // Worst case conversion time in microseconds for the current resolution
+    unsigned long conversionMicros() const;
     //*********************************************************************
     // Additional methods to extract temperature, pressure (mbar), and the 
     // D1,D2 values after readSensor() has been called
@@ -79,12 +91,26 @@ private:
     unsigned long D1;	// Store D1 value
     unsigned long D2;	// Store D2 value
     int32_t mbarInt; // pressure in mbar, initially as a signed long integer
+    // Calibration coefficients read from the PROM, one set per sensor
+    unsigned int sensorCoeffs[8];
     // Check data integrity with CRC4
     unsigned char MS_5803_CRC(unsigned int n_prom[]); 
     // Handles commands to the sensor.
     unsigned long MS_5803_ADC(char commandADC);
+    // Start a conversion and read its result once done
+    void startConversion(char commandADC);
+    unsigned long readADC();
+    // Compute mbar and tempC from D1 and D2
+    void calculate();
     // Oversampling resolution
     uint16_t _Resolution;
+    char resolutionCommand() const;
+    // State of the conversion started by poll()
+    enum Conversion { IDLE, CONVERTING_D1, CONVERTING_D2 };
+    Conversion conversion;
+    unsigned long conversionStart;
+    unsigned long conversionTime;
+    static unsigned long conversionMicros(char resolutionCommand);
 };
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,438 @@
+#include <Arduino.h>
+#include <NativeHAL.hpp>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <random>
+
+namespace {
+    using SteadyClock = std::chrono::steady_clock;
+
+    struct Clock {
+        SteadyClock::time_point start = SteadyClock::now();
+        uint64_t skipped              = 0;  // micros added by delay() and advance()
+        uint64_t frozenAt             = 0;
+        uint64_t lastNotified         = 0;
+        bool frozen                   = false;
+        bool notifying                = false;
+    };
+
+    struct Interrupt {
+        voidFuncPtr callback = nullptr;
+        uint32_t mode        = 0;
+        bool pending         = false;
+    };
+
+    struct Hardware {
+        Clock clock;
+        std::map<int, NativeHAL::TimeListener> listeners;
+        std::map<int, NativeHAL::WakeSource> wakeSources;
+        int nextHandle = 0;
+
+        int modes[NUM_DIGITAL_PINS]{};
+        int levels[NUM_DIGITAL_PINS]{};
+        int analogValues[NUM_DIGITAL_PINS]{};
+        Interrupt handlers[NUM_DIGITAL_PINS];
+        bool interruptsEnabled = true;
+
+        std::vector<uint8_t> shifting;
+        NativeHAL::ShiftRegisterCapture shiftRegister;
+
+        std::deque<char> serialIn;
+        std::string serialOut;
+        bool serialEcho = true;
+
+        std::mt19937 rng;
+    };
+
+    Hardware & hw() {
+        static Hardware instance;
+        return instance;
+    }
+
+    bool validPin(uint32_t pin) {
+        return pin < NUM_DIGITAL_PINS;
+    }
+
+    uint64_t clockMicros() {
+        auto & clock = hw().clock;
+        if (clock.frozen) {
+            return clock.frozenAt + clock.skipped;
+        }
+
+        auto real = std::chrono::duration_cast<std::chrono::microseconds>(
+            SteadyClock::now() - clock.start);
+        return real.count() + clock.skipped;
+    }
+
+    // Let time listeners observe the time elapsed since they last ran. Guarded so that
+    // listeners (and the interrupt handlers they fire) can read the clock.
+    void notify() {
+        auto & clock = hw().clock;
+        if (clock.notifying || hw().listeners.empty()) {
+            return;
+        }
+
+        const uint64_t to = clockMicros();
+        if (to <= clock.lastNotified) {
+            return;
+        }
+
+        clock.notifying     = true;
+        const uint64_t from = clock.lastNotified;
+        clock.lastNotified  = to;
+        auto listeners      = hw().listeners;
+        for (auto & kv : listeners) {
+            kv.second(from, to);
+        }
+
+        clock.notifying = false;
+    }
+
+    void fire(uint32_t pin) {
+        auto & handler = hw().handlers[pin];
+        if (!handler.callback) {
+            return;
+        }
+
+        if (hw().interruptsEnabled) {
+            handler.pending = false;
+            handler.callback();
+        } else {
+            handler.pending = true;
+        }
+    }
+}  // namespace
+
+// ─── TIME ────────────────────────────────────────────────────────────────────
+unsigned long millis() {
+    notify();
+    return clockMicros() / 1000;
+}
+
+unsigned long micros() {
+    notify();
+    return clockMicros();
+}
+
+void delay(unsigned long ms) {
+    NativeHAL::advanceMicros(uint64_t(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    NativeHAL::advanceMicros(us);
+}
+
+void yield() {
+    notify();
+}
+
+// ─── PINS ────────────────────────────────────────────────────────────────────
+void pinMode(uint32_t pin, uint32_t mode) {
+    if (!validPin(pin)) {
+        return;
+    }
+
+    hw().modes[pin] = mode;
+    if (mode == INPUT_PULLUP) {
+        hw().levels[pin] = HIGH;
+    } else if (mode == INPUT_PULLDOWN) {
+        hw().levels[pin] = LOW;
+    }
+}
+
+void digitalWrite(uint32_t pin, uint32_t value) {
+    if (!validPin(pin)) {
+        return;
+    }
+
+    const int level    = value ? HIGH : LOW;
+    const int previous = hw().levels[pin];
+    hw().levels[pin]   = level;
+
+    // Rising edge on any output latches whatever was shifted out since the last latch
+    auto & capture = hw().shiftRegister;
+    if (previous == LOW && level == HIGH && !hw().shifting.empty()) {
+        capture.latched = hw().shifting;
+        capture.latches++;
+        hw().shifting.clear();
+    }
+}
+
+int digitalRead(uint32_t pin) {
+    return validPin(pin) ? hw().levels[pin] : LOW;
+}
+
+int analogRead(uint32_t pin) {
+    return validPin(pin) ? hw().analogValues[pin] : 0;
+}
+
+void analogWrite(uint32_t pin, uint32_t value) {
+    if (validPin(pin)) {
+        hw().analogValues[pin] = value;
+        hw().levels[pin]       = value ? HIGH : LOW;
+    }
+}
+
+void analogReadResolution(int bits) {}
+void analogWriteResolution(int bits) {}
+
+void shiftOut(uint32_t dataPin, uint32_t clockPin, uint32_t bitOrder, uint32_t value) {
+    uint8_t data = value;
+    if (bitOrder == LSBFIRST) {
+        uint8_t reversed = 0;
+        for (int i = 0; i < 8; i++) {
+            reversed |= ((data >> i) & 1) << (7 - i);
+        }
+
+        data = reversed;
+    }
+
+    // Stored MSB first regardless of the bit order used on the wire
+    hw().shifting.push_back(data);
+    hw().shiftRegister.bytes++;
+}
+
+// ─── INTERRUPTS ──────────────────────────────────────────────────────────────
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode) {
+    if (validPin(pin)) {
+        hw().handlers[pin] = {callback, mode, false};
+    }
+}
+
+void detachInterrupt(uint32_t pin) {
+    if (validPin(pin)) {
+        hw().handlers[pin] = {};
+    }
+}
+
+void interrupts() {
+    hw().interruptsEnabled = true;
+    for (uint32_t pin = 0; pin < NUM_DIGITAL_PINS; pin++) {
+        if (hw().handlers[pin].pending) {
+            fire(pin);
+        }
+    }
+}
+
+void noInterrupts() {
+    hw().interruptsEnabled = false;
+}
+
+// ─── MATH ────────────────────────────────────────────────────────────────────
+long random(long max) {
+    return max <= 0 ? 0 : random(0, max);
+}
+
+long random(long min, long max) {
+    if (min >= max) {
+        return min;
+    }
+
+    return std::uniform_int_distribution<long>(min, max - 1)(hw().rng);
+}
+
+void randomSeed(unsigned long seed) {
+    hw().rng.seed(seed);
+}
+
+long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ─── SERIAL ──────────────────────────────────────────────────────────────────
+HostSerial Serial;
+
+int HostSerial::available() {
+    return hw().serialIn.size();
+}
+
+int HostSerial::read() {
+    if (hw().serialIn.empty()) {
+        return -1;
+    }
+
+    char c = hw().serialIn.front();
+    hw().serialIn.pop_front();
+    return static_cast<uint8_t>(c);
+}
+
+int HostSerial::peek() {
+    return hw().serialIn.empty() ? -1 : static_cast<uint8_t>(hw().serialIn.front());
+}
+
+void HostSerial::flush() {
+    fflush(stdout);
+}
+
+size_t HostSerial::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t HostSerial::write(const uint8_t * buffer, size_t size) {
+    // Keep only the most recent output so long runs don't grow without bound
+    auto & output = hw().serialOut;
+    output.append(reinterpret_cast<const char *>(buffer), size);
+    if (output.size() > 64 * 1024) {
+        output.erase(0, output.size() - 32 * 1024);
+    }
+
+    if (hw().serialEcho) {
+        fwrite(buffer, 1, size, stdout);
+    }
+
+    return size;
+}
+
+//
+// ─── CONTROL SURFACE ────────────────────────────────────────────────────────────
+//
+namespace NativeHAL {
+    void freezeClock(bool frozen) {
+        auto & clock = hw().clock;
+        if (frozen == clock.frozen) {
+            return;
+        }
+
+        const uint64_t current = clockMicros();
+        clock.frozen           = frozen;
+        if (frozen) {
+            clock.frozenAt = current - clock.skipped;
+        } else {
+            // Resume from the same point so the clock never goes backward
+            clock.start   = SteadyClock::now();
+            clock.skipped = current;
+        }
+    }
+
+    bool isClockFrozen() {
+        return hw().clock.frozen;
+    }
+
+    void advance(unsigned long ms) {
+        advanceMicros(uint64_t(ms) * 1000);
+    }
+
+    void advanceMicros(uint64_t us) {
+        hw().clock.skipped += us;
+        notify();
+    }
+
+    uint64_t elapsedMicros() {
+        return clockMicros();
+    }
+
+    int addTimeListener(TimeListener listener) {
+        int handle             = hw().nextHandle++;
+        hw().listeners[handle] = listener;
+        if (hw().listeners.size() == 1) {
+            hw().clock.lastNotified = clockMicros();
+        }
+
+        return handle;
+    }
+
+    void removeTimeListener(int handle) {
+        hw().listeners.erase(handle);
+    }
+
+    int addWakeSource(WakeSource source) {
+        int handle               = hw().nextHandle++;
+        hw().wakeSources[handle] = source;
+        return handle;
+    }
+
+    void removeWakeSource(int handle) {
+        hw().wakeSources.erase(handle);
+    }
+
+    bool standby() {
+        uint64_t wake = 0;
+        for (auto & kv : hw().wakeSources) {
+            uint64_t next = kv.second();
+            if (next && (!wake || next < wake)) {
+                wake = next;
+            }
+        }
+
+        if (!wake) {
+            return false;
+        }
+
+        const uint64_t current = clockMicros();
+        if (wake > current) {
+            advanceMicros(wake - current);
+        } else {
+            notify();
+        }
+
+        return true;
+    }
+
+    void setPinLevel(uint32_t pin, int level) {
+        if (!validPin(pin)) {
+            return;
+        }
+
+        level              = level ? HIGH : LOW;
+        const int previous = hw().levels[pin];
+        hw().levels[pin]   = level;
+
+        const auto mode = hw().handlers[pin].mode;
+        if ((mode == CHANGE && previous != level) || (mode == RISING && !previous && level)
+            || (mode == FALLING && previous && !level) || (mode == LOW && !level)
+            || (mode == HIGH && level)) {
+            fire(pin);
+        }
+    }
+
+    int pinLevel(uint32_t pin) {
+        return digitalRead(pin);
+    }
+
+    int pinMode(uint32_t pin) {
+        return validPin(pin) ? hw().modes[pin] : INPUT;
+    }
+
+    void setAnalogValue(uint32_t pin, int value) {
+        if (validPin(pin)) {
+            hw().analogValues[pin] = value;
+        }
+    }
+
+    bool interruptsEnabled() {
+        return hw().interruptsEnabled;
+    }
+
+    const ShiftRegisterCapture & shiftRegister() {
+        return hw().shiftRegister;
+    }
+
+    void serialInput(const char * text) {
+        while (*text) {
+            hw().serialIn.push_back(*text++);
+        }
+    }
+
+    void setSerialEcho(bool echo) {
+        hw().serialEcho = echo;
+    }
+
+    std::string & serialOutput() {
+        return hw().serialOut;
+    }
+
+    void reset() {
+        auto & h = hw();
+        std::fill_n(h.modes, NUM_DIGITAL_PINS, INPUT);
+        std::fill_n(h.levels, NUM_DIGITAL_PINS, LOW);
+        std::fill_n(h.analogValues, NUM_DIGITAL_PINS, 0);
+        std::fill_n(h.handlers, NUM_DIGITAL_PINS, Interrupt{});
+        h.interruptsEnabled = true;
+        h.shifting.clear();
+        h.shiftRegister = {};
+        h.serialIn.clear();
+        h.serialOut.clear();
+    }
+}  // namespace NativeHAL
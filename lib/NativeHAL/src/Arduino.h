@@ -0,0 +1,137 @@
+#pragma once
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include <Print.h>
+#include <Printable.h>
+#include <Stream.h>
+#include <WString.h>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: A R D U I N O : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Host replacement for the Arduino SAMD core. Only the parts used by the firmware, the
+// framework and the sensor libraries are implemented. The test harness controls the clock,
+// pins and serial input through NativeHAL.hpp.
+//
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+typedef void (*voidFuncPtr)(void);
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT          0x0
+#define OUTPUT         0x1
+#define INPUT_PULLUP   0x2
+#define INPUT_PULLDOWN 0x3
+
+#define CHANGE  2
+#define FALLING 3
+#define RISING  4
+
+enum BitOrder { LSBFIRST = 0, MSBFIRST = 1 };
+
+// Adafruit Feather M0 pin numbers
+#define A0          14
+#define A1          15
+#define A2          16
+#define A3          17
+#define A4          18
+#define A5          19
+#define LED_BUILTIN 13
+#define NUM_DIGITAL_PINS 26
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define lowByte(w)  ((uint8_t) ((w) &0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+
+#define bit(b)                      (1UL << (b))
+#define bitRead(value, b)           (((value) >> (b)) & 0x01)
+#define bitSet(value, b)            ((value) |= (1UL << (b)))
+#define bitClear(value, b)          ((value) &= ~(1UL << (b)))
+#define bitWrite(value, b, bitvalue) ((bitvalue) ? bitSet(value, b) : bitClear(value, b))
+
+#define digitalPinToInterrupt(p) (p)
+
+template <typename T, typename L, typename H>
+auto constrain(T x, L low, H high) -> decltype(x < low ? low : (x > high ? high : x)) {
+    return x < low ? low : (x > high ? high : x);
+}
+
+// ─── TIME ────────────────────────────────────────────────────────────────────
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ─── PINS ────────────────────────────────────────────────────────────────────
+void pinMode(uint32_t pin, uint32_t mode);
+void digitalWrite(uint32_t pin, uint32_t value);
+int digitalRead(uint32_t pin);
+int analogRead(uint32_t pin);
+void analogWrite(uint32_t pin, uint32_t value);
+void analogReadResolution(int bits);
+void analogWriteResolution(int bits);
+void shiftOut(uint32_t dataPin, uint32_t clockPin, uint32_t bitOrder, uint32_t value);
+
+// ─── INTERRUPTS ──────────────────────────────────────────────────────────────
+void attachInterrupt(uint32_t pin, voidFuncPtr callback, uint32_t mode);
+void detachInterrupt(uint32_t pin);
+void interrupts();
+void noInterrupts();
+
+// ─── MATH ────────────────────────────────────────────────────────────────────
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+
+// ─── SERIAL ──────────────────────────────────────────────────────────────────
+class HostSerial : public Stream {
+public:
+    void begin(unsigned long baud) {}
+    void end() {}
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+
+    int availableForWrite() override {
+        return 64;
+    }
+
+    // USB serial is always "connected" on the host
+    explicit operator bool() {
+        return true;
+    }
+};
+
+extern HostSerial Serial;
+
+// Arduino sketch entry points
+void setup();
+void loop();
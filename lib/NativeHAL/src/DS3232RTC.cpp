@@ -0,0 +1,228 @@
+#include <DS3232RTC.h>
+#include <NativeHAL.hpp>
+#include <Wire.h>
+
+DS3232RTC RTC;
+
+namespace {
+    struct Alarm {
+        ALARM_TYPES_t type = ALM1_MATCH_DATE;
+        byte seconds       = 0;
+        byte minutes       = 0;
+        byte hours         = 0;
+        byte daydate       = 0;
+        time_t nextFire    = 0;  // 0 when the alarm registers were never written
+        bool flag          = false;
+        bool interrupt     = false;
+    };
+
+    struct Chip {
+        // RTC time = offset + virtual clock seconds
+        time_t offset = ::time(nullptr);
+        Alarm alarms[2];
+        bool squareWave  = false;
+        int interruptPin = -1;
+        NativeHAL::ScriptedI2CDevice presence;
+
+        Chip() {
+            presence.onRequest = [](uint8_t * buffer, size_t quantity) {
+                std::fill_n(buffer, quantity, 0);
+                return quantity;
+            };
+
+            NativeHAL::attachI2CDevice(0x68, &presence);
+            NativeHAL::addTimeListener([this](uint64_t, uint64_t) { update(); });
+            NativeHAL::addWakeSource([this]() -> uint64_t {
+                time_t next = NativeHAL::rtcNextAlarm();
+                if (!next) {
+                    return 0;
+                }
+
+                return uint64_t(next - offset) * 1000000;
+            });
+        }
+
+        time_t current() const {
+            return offset + NativeHAL::elapsedMicros() / 1000000;
+        }
+
+        // First time strictly after `after` that matches the alarm registers
+        static time_t nextMatch(const Alarm & alarm, time_t after) {
+            const int mode          = alarm.type & 0x1F;  // strip the alarm 2 marker
+            const time_t minuteBase = (after / SECS_PER_MIN) * SECS_PER_MIN;
+            const time_t hourBase   = (after / SECS_PER_HOUR) * SECS_PER_HOUR;
+            const time_t dayBase    = previousMidnight(after);
+            const time_t inDay
+                = alarm.hours * SECS_PER_HOUR + alarm.minutes * SECS_PER_MIN + alarm.seconds;
+
+            switch (alarm.type) {
+            case ALM1_EVERY_SECOND:
+                return after + 1;
+            case ALM2_EVERY_MINUTE:
+                return minuteBase + SECS_PER_MIN;
+            case ALM1_MATCH_SECONDS: {
+                time_t t = minuteBase + alarm.seconds;
+                return t > after ? t : t + SECS_PER_MIN;
+            }
+            case ALM1_MATCH_MINUTES:
+            case ALM2_MATCH_MINUTES: {
+                time_t t = hourBase + alarm.minutes * SECS_PER_MIN + alarm.seconds;
+                return t > after ? t : t + SECS_PER_HOUR;
+            }
+            case ALM1_MATCH_HOURS:
+            case ALM2_MATCH_HOURS: {
+                time_t t = dayBase + inDay;
+                return t > after ? t : t + SECS_PER_DAY;
+            }
+            default:
+                break;
+            }
+
+            // Date or day of week match. At most two months ahead.
+            for (int days = 0; days < 62; days++) {
+                time_t t = dayBase + days * SECS_PER_DAY + inDay;
+                if (t <= after) {
+                    continue;
+                }
+
+                const bool dayOfWeek = mode == (ALM1_MATCH_DAY & 0x1F);
+                if ((dayOfWeek && weekday(t) == alarm.daydate)
+                    || (!dayOfWeek && day(t) == alarm.daydate)) {
+                    return t;
+                }
+            }
+
+            return 0;
+        }
+
+        void update() {
+            const time_t t = current();
+            for (auto & alarm : alarms) {
+                if (alarm.nextFire && t >= alarm.nextFire) {
+                    alarm.flag     = true;
+                    alarm.nextFire = nextMatch(alarm, t);
+                }
+            }
+
+            updateInterruptPin();
+        }
+
+        void updateInterruptPin() {
+            if (interruptPin < 0 || squareWave) {
+                return;
+            }
+
+            bool asserted = false;
+            for (auto & alarm : alarms) {
+                asserted = asserted || (alarm.flag && alarm.interrupt);
+            }
+
+            NativeHAL::setPinLevel(interruptPin, asserted ? LOW : HIGH);
+        }
+    };
+
+    Chip & chip() {
+        static Chip instance;
+        return instance;
+    }
+}  // namespace
+
+// Creating the chip right away attaches it to the bus before anyone probes for it
+DS3232RTC::DS3232RTC(bool initI2C) {
+    chip();
+}
+
+void DS3232RTC::begin() {
+    chip();
+}
+
+time_t DS3232RTC::get() {
+    chip().update();
+    return chip().current();
+}
+
+byte DS3232RTC::set(time_t t) {
+    chip().offset = t - NativeHAL::elapsedMicros() / 1000000;
+    for (auto & alarm : chip().alarms) {
+        if (alarm.nextFire) {
+            alarm.nextFire = Chip::nextMatch(alarm, t);
+        }
+    }
+
+    return 0;
+}
+
+byte DS3232RTC::read(tmElements_t & tm) {
+    breakTime(get(), tm);
+    return 0;
+}
+
+byte DS3232RTC::write(tmElements_t & tm) {
+    return set(makeTime(tm));
+}
+
+void DS3232RTC::setAlarm(ALARM_TYPES_t alarmType, byte seconds, byte minutes, byte hours,
+                         byte daydate) {
+    Alarm & alarm  = chip().alarms[(alarmType & 0x80) ? 1 : 0];
+    alarm.type     = alarmType;
+    alarm.seconds  = (alarmType & 0x80) ? 0 : seconds;
+    alarm.minutes  = minutes;
+    alarm.hours    = hours;
+    alarm.daydate  = daydate;
+    alarm.nextFire = Chip::nextMatch(alarm, chip().current());
+}
+
+void DS3232RTC::setAlarm(ALARM_TYPES_t alarmType, byte minutes, byte hours, byte daydate) {
+    setAlarm(alarmType, 0, minutes, hours, daydate);
+}
+
+void DS3232RTC::alarmInterrupt(byte alarmNumber, bool alarmEnabled) {
+    if (alarmNumber == ALARM_1 || alarmNumber == ALARM_2) {
+        chip().alarms[alarmNumber - 1].interrupt = alarmEnabled;
+        chip().updateInterruptPin();
+    }
+}
+
+// Returns true if the alarm flag is set and clears it (same as the library)
+bool DS3232RTC::alarm(byte alarmNumber) {
+    if (alarmNumber != ALARM_1 && alarmNumber != ALARM_2) {
+        return false;
+    }
+
+    chip().update();
+    Alarm & alarm = chip().alarms[alarmNumber - 1];
+    bool flag     = alarm.flag;
+    alarm.flag    = false;
+    chip().updateInterruptPin();
+    return flag;
+}
+
+void DS3232RTC::squareWave(SQWAVE_FREQS_t freq) {
+    chip().squareWave = freq != SQWAVE_NONE;
+}
+
+bool DS3232RTC::oscStopped(bool clearOSF) {
+    return false;
+}
+
+int DS3232RTC::temperature() {
+    return 25 * 4;  // quarter degrees
+}
+
+namespace NativeHAL {
+    void setRTCInterruptPin(int pin) {
+        chip().interruptPin = pin;
+        chip().updateInterruptPin();
+    }
+
+    time_t rtcNextAlarm() {
+        time_t next = 0;
+        for (auto & alarm : chip().alarms) {
+            if (alarm.interrupt && alarm.nextFire && (!next || alarm.nextFire < next)) {
+                next = alarm.nextFire;
+            }
+        }
+
+        return next;
+    }
+}  // namespace NativeHAL
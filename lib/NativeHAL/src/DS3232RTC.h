@@ -0,0 +1,61 @@
+#pragma once
+#include <Arduino.h>
+#include <TimeLib.h>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: D S 3 2 3 2 R T C : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Host replacement for JChristensen/DS3232RTC 1.3.0. There is a single simulated chip that
+// keeps time on the virtual clock. Alarms set their flag when the RTC time matches and, if
+// their interrupt is enabled, pull the INT/SQW pin low (see NativeHAL::setRTCInterruptPin).
+// The chip also answers at 0x68 on the I2C bus so that presence checks succeed.
+//
+enum ALARM_TYPES_t {
+    ALM1_EVERY_SECOND  = 0x0F,
+    ALM1_MATCH_SECONDS = 0x0E,
+    ALM1_MATCH_MINUTES = 0x0C,
+    ALM1_MATCH_HOURS   = 0x08,
+    ALM1_MATCH_DATE    = 0x00,
+    ALM1_MATCH_DAY     = 0x10,
+    ALM2_EVERY_MINUTE  = 0x8E,
+    ALM2_MATCH_MINUTES = 0x8C,
+    ALM2_MATCH_HOURS   = 0x88,
+    ALM2_MATCH_DATE    = 0x80,
+    ALM2_MATCH_DAY     = 0x90,
+};
+
+enum SQWAVE_FREQS_t { SQWAVE_1_HZ, SQWAVE_1024_HZ, SQWAVE_4096_HZ, SQWAVE_8192_HZ, SQWAVE_NONE };
+
+#define ALARM_1 1
+#define ALARM_2 2
+
+class DS3232RTC {
+public:
+    DS3232RTC(bool initI2C = true);
+
+    void begin();
+    static time_t get();
+    byte set(time_t t);
+    byte read(tmElements_t & tm);
+    byte write(tmElements_t & tm);
+
+    void setAlarm(ALARM_TYPES_t alarmType, byte seconds, byte minutes, byte hours, byte daydate);
+    void setAlarm(ALARM_TYPES_t alarmType, byte minutes, byte hours, byte daydate);
+    void alarmInterrupt(byte alarmNumber, bool alarmEnabled);
+    bool alarm(byte alarmNumber);
+    void squareWave(SQWAVE_FREQS_t freq);
+    bool oscStopped(bool clearOSF = false);
+    int temperature();
+};
+
+extern DS3232RTC RTC;
+
+namespace NativeHAL {
+    // Pin wired to the RTC INT/SQW output (active low). -1 if not connected.
+    void setRTCInterruptPin(int pin);
+
+    // RTC epoch at which the next alarm with its interrupt enabled fires, or 0 if none
+    time_t rtcNextAlarm();
+}  // namespace NativeHAL
@@ -0,0 +1,99 @@
+#pragma once
+#include <Wire.h>
+#include <NativeHAL.hpp>
+
+namespace NativeHAL {
+    //
+    // TE MS5803-02BA barometric sensor (I2C). Conversions take as long as the datasheet says;
+    // reading the ADC before a conversion finishes returns 0, same as the real part.
+    //
+    class MS5803Device : public I2CDevice {
+    public:
+        float pressure            = 1013.25;  // mbar
+        float temperature         = 20;       // °C
+        unsigned long conversions = 0;
+
+    private:
+        // Datasheet example coefficients with a matching CRC in C7
+        uint16_t prom[8] = {0, 46372, 43981, 29059, 27842, 31553, 28165, 0};
+
+        uint8_t command  = 0;
+        uint32_t adc     = 0;
+        uint64_t readyAt = 0;
+
+    public:
+        MS5803Device() {
+            prom[7] = crc();
+        }
+
+        bool receive(const uint8_t * data, size_t size) override {
+            if (size == 0) {
+                return true;
+            }
+
+            command = data[0];
+            if ((command & 0xF0) == 0x40 || (command & 0xF0) == 0x50) {
+                static const uint32_t conversionMicros[] = {600, 1170, 2280, 4540, 9040};
+                const int osr = ((command & 0x0F) >> 1) % 5;
+                readyAt       = elapsedMicros() + conversionMicros[osr];
+                adc           = (command & 0xF0) == 0x40 ? rawPressure() : rawTemperature();
+                conversions++;
+            }
+
+            return true;
+        }
+
+        size_t request(uint8_t * buffer, size_t quantity) override {
+            if (command == 0x00 && quantity >= 3) {
+                const uint32_t value = elapsedMicros() >= readyAt ? adc : 0;
+                buffer[0]            = value >> 16;
+                buffer[1]            = value >> 8;
+                buffer[2]            = value;
+                adc                  = 0;
+                return 3;
+            }
+
+            if (command >= 0xA0 && command <= 0xAE && quantity >= 2) {
+                const uint16_t value = prom[(command - 0xA0) >> 1];
+                buffer[0]            = value >> 8;
+                buffer[1]            = value & 0xFF;
+                return 2;
+            }
+
+            return 0;
+        }
+
+    private:
+        // First order inverse of the compensation in the datasheet
+        int32_t dT() const {
+            return (int64_t(temperature * 100) - 2000) * 8388608LL / prom[6];
+        }
+
+        uint32_t rawTemperature() const {
+            return int64_t(prom[5]) * 256 + dT();
+        }
+
+        uint32_t rawPressure() const {
+            const int64_t offset      = int64_t(prom[2]) * 131072 + (prom[4] * int64_t(dT())) / 64;
+            const int64_t sensitivity = int64_t(prom[1]) * 65536 + (prom[3] * int64_t(dT())) / 128;
+            return ((int64_t(pressure * 100) * 32768 + offset) * 2097152) / sensitivity;
+        }
+
+        // AN520 CRC-4 over the PROM with the CRC byte cleared
+        uint8_t crc() const {
+            uint16_t words[8];
+            memcpy(words, prom, sizeof(words));
+            words[7] &= 0xFF00;
+
+            uint16_t remainder = 0;
+            for (int i = 0; i < 16; i++) {
+                remainder ^= (i % 2 == 1) ? (words[i >> 1] & 0x00FF) : (words[i >> 1] >> 8);
+                for (int bit = 8; bit > 0; bit--) {
+                    remainder = (remainder & 0x8000) ? (remainder << 1) ^ 0x3000 : remainder << 1;
+                }
+            }
+
+            return (remainder >> 12) & 0x0F;
+        }
+    };
+}  // namespace NativeHAL
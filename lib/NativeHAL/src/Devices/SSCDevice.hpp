@@ -0,0 +1,47 @@
+#pragma once
+#include <Wire.h>
+
+namespace NativeHAL {
+    //
+    // Honeywell TruStability SSC pressure sensor (I2C). A read returns the 14-bit bridge data
+    // with the two status bits on top, followed by the 11-bit temperature.
+    //
+    class SSCDevice : public I2CDevice {
+    public:
+        enum Status : uint8_t { normal = 0, command = 1, stale = 2, diagnostic = 3 };
+
+        // Transfer function used by PressureSensor
+        uint16_t minRaw   = 1638;
+        uint16_t maxRaw   = 14745;
+        float minPressure = 0;
+        float maxPressure = 30;
+
+        float pressure      = 0;   // psi
+        float temperature   = 20;  // °C
+        Status status       = normal;
+        unsigned long reads = 0;
+
+        bool receive(const uint8_t * data, size_t size) override {
+            return true;
+        }
+
+        size_t request(uint8_t * buffer, size_t quantity) override {
+            reads++;
+
+            float ratio    = (pressure - minPressure) / (maxPressure - minPressure);
+            ratio          = ratio < 0 ? 0 : (ratio > 1 ? 1 : ratio);
+            uint16_t raw   = minRaw + ratio * (maxRaw - minRaw);
+            uint16_t temp  = (temperature + 50) / 200 * 2047;
+            uint8_t data[] = {
+                static_cast<uint8_t>((status << 6) | ((raw >> 8) & 0x3F)),
+                static_cast<uint8_t>(raw & 0xFF),
+                static_cast<uint8_t>((temp << 5) >> 8),
+                static_cast<uint8_t>((temp << 5) & 0xFF),
+            };
+
+            size_t n = quantity < sizeof(data) ? quantity : sizeof(data);
+            memcpy(buffer, data, n);
+            return n;
+        }
+    };
+}  // namespace NativeHAL
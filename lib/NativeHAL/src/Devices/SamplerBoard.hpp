@@ -0,0 +1,38 @@
+#pragma once
+#include <DS3232RTC.h>
+#include <NativeHAL.hpp>
+#include <SD.h>
+#include <Wire.h>
+
+#include <Devices/MS5803Device.hpp>
+#include <Devices/SSCDevice.hpp>
+
+namespace NativeHAL {
+    //
+    // The peripherals of the sampler board on the I2C bus, and the setup every harness that
+    // runs the App starts from: frozen clock, SD card copied from a template, sensors
+    // attached at their addresses and the RTC alarm wired to its interrupt pin.
+    //
+    struct SamplerBoard {
+        SSCDevice pressureSensor;
+        MS5803Device baro1;
+        MS5803Device baro2;
+
+        /** ────────────────────────────────────────────────────────────────────────────
+         *  @brief Prepare the host hardware. Call once before App::setup().
+         *
+         *  @param rtcInterruptPin Pin the RTC pulls low when an alarm fires
+         *  @param sdTemplate Directory copied to the SD card (ex: sdcard_template)
+         *  ──────────────────────────────────────────────────────────────────────────── */
+        void begin(int rtcInterruptPin, const char * sdTemplate) {
+            setSerialEcho(getenv("NATIVE_VERBOSE") != nullptr);
+            freezeClock(true);
+            mountSD(".pio/native-sd", sdTemplate);
+
+            attachI2CDevice(0x08, &pressureSensor);
+            attachI2CDevice(0x77, &baro1);
+            attachI2CDevice(0x76, &baro2);
+            setRTCInterruptPin(rtcInterruptPin);
+        }
+    };
+}  // namespace NativeHAL
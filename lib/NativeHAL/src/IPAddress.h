@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+
+class IPAddress : public Printable {
+private:
+    uint8_t bytes[4]{0};
+
+public:
+    IPAddress() = default;
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : bytes{a, b, c, d} {}
+    IPAddress(uint32_t address) {
+        memcpy(bytes, &address, sizeof(bytes));
+    }
+
+    operator uint32_t() const {
+        uint32_t address;
+        memcpy(&address, bytes, sizeof(address));
+        return address;
+    }
+
+    uint8_t operator[](int index) const {
+        return bytes[index];
+    }
+
+    uint8_t & operator[](int index) {
+        return bytes[index];
+    }
+
+    size_t printTo(Print & p) const override {
+        size_t n = 0;
+        for (int i = 0; i < 4; i++) {
+            n += p.print(bytes[i], DEC);
+            if (i < 3) {
+                n += p.print('.');
+            }
+        }
+
+        return n;
+    }
+};
@@ -0,0 +1,3 @@
+#include <LowPower.h>
+
+LowPowerClass LowPower;
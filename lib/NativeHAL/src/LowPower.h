@@ -0,0 +1,20 @@
+#pragma once
+#include <Arduino.h>
+#include <NativeHAL.hpp>
+
+//
+// Host replacement for the Low-Power library. Standby jumps the virtual clock to the next wake
+// source (ex: an armed RTC alarm) instead of stopping the CPU.
+//
+class LowPowerClass {
+public:
+    void idle() {}
+
+    void standby() {
+        if (!NativeHAL::standby()) {
+            Serial.println("LowPower: standby without a wake source, continuing");
+        }
+    }
+};
+
+extern LowPowerClass LowPower;
@@ -0,0 +1,69 @@
+#pragma once
+#include <Arduino.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: N A T I V E   H A L : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Control surface for the host hardware layer. The firmware never includes this file; only
+// test harnesses and simulations do.
+//
+namespace NativeHAL {
+    // ─── CLOCK ───────────────────────────────────────────────────────────────
+    // By default millis()/micros() follow the host steady clock plus any time skipped by
+    // delay() or advance(). In frozen mode the clock only moves through delay()/advance(),
+    // which makes simulations deterministic.
+    void freezeClock(bool frozen);
+    bool isClockFrozen();
+    void advance(unsigned long ms);
+    void advanceMicros(uint64_t us);
+    uint64_t elapsedMicros();
+
+    // Called whenever the clock moves forward with the time span [from, to) in micros.
+    // Used to model time-based hardware (alarms, sensor pulses). Listeners run with the
+    // clock already at "to".
+    using TimeListener = std::function<void(uint64_t from, uint64_t to)>;
+    int addTimeListener(TimeListener listener);
+    void removeTimeListener(int handle);
+
+    // Sources that can wake the chip from standby. Each returns the elapsedMicros() at which
+    // it will next fire, or 0 if it won't. standby() jumps the clock to the earliest one and
+    // returns false if nothing can wake the chip.
+    using WakeSource = std::function<uint64_t()>;
+    int addWakeSource(WakeSource source);
+    void removeWakeSource(int handle);
+    bool standby();
+
+    // ─── PINS ────────────────────────────────────────────────────────────────
+    // Drive an input pin. Fires the attached interrupt handler if the level change matches
+    // its mode. When interrupts are disabled, the handler runs on the next interrupts() call.
+    void setPinLevel(uint32_t pin, int level);
+    int pinLevel(uint32_t pin);
+    int pinMode(uint32_t pin);
+    void setAnalogValue(uint32_t pin, int value);
+    bool interruptsEnabled();
+
+    // ─── SHIFT REGISTER ──────────────────────────────────────────────────────
+    // Bytes passed to shiftOut() are collected until any output pin rises, which the
+    // 74HC595/TPIC6B595 treat as the latch clock.
+    struct ShiftRegisterCapture {
+        std::vector<uint8_t> latched;  // bytes in the order they were shifted out
+        unsigned long latches = 0;     // number of latch edges that moved data to the outputs
+        unsigned long bytes   = 0;     // number of bytes shifted out in total
+    };
+
+    const ShiftRegisterCapture & shiftRegister();
+
+    // ─── SERIAL ──────────────────────────────────────────────────────────────
+    void serialInput(const char * text);
+    void setSerialEcho(bool echo);
+    std::string & serialOutput();
+
+    // Reset pins, interrupts, serial buffers and the shift register capture
+    void reset();
+}  // namespace NativeHAL
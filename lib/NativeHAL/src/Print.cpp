@@ -0,0 +1,133 @@
+#include <Print.h>
+#include <math.h>
+#include <stdio.h>
+
+size_t Print::write(const uint8_t * buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        if (!write(*buffer++)) {
+            break;
+        }
+
+        n++;
+    }
+
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper * str) {
+    return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const String & str) {
+    return write(str.c_str(), str.length());
+}
+
+size_t Print::print(const char str[]) {
+    return write(str);
+}
+
+size_t Print::print(char c) {
+    return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(unsigned char n, int base) {
+    return print(static_cast<unsigned long>(n), base);
+}
+
+size_t Print::print(int n, int base) {
+    return print(static_cast<long long>(n), base);
+}
+
+size_t Print::print(unsigned int n, int base) {
+    return print(static_cast<unsigned long long>(n), base);
+}
+
+size_t Print::print(long n, int base) {
+    return print(static_cast<long long>(n), base);
+}
+
+size_t Print::print(unsigned long n, int base) {
+    return print(static_cast<unsigned long long>(n), base);
+}
+
+size_t Print::print(long long n, int base) {
+    if (base == 0) {
+        return write(static_cast<uint8_t>(n));
+    }
+
+    if (base == 10 && n < 0) {
+        size_t t = print('-');
+        return printNumber(static_cast<unsigned long long>(-n), 10) + t;
+    }
+
+    return printNumber(static_cast<unsigned long long>(n), base);
+}
+
+size_t Print::print(unsigned long long n, int base) {
+    if (base == 0) {
+        return write(static_cast<uint8_t>(n));
+    }
+
+    return printNumber(n, base);
+}
+
+size_t Print::print(double n, int digits) {
+    return printFloat(n, digits);
+}
+
+size_t Print::print(const Printable & printable) {
+    return printable.printTo(*this);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+// clang-format off
+size_t Print::println(const __FlashStringHelper * str) { return print(str) + println(); }
+size_t Print::println(const String & str) { return print(str) + println(); }
+size_t Print::println(const char str[]) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base) { return print(n, base) + println(); }
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base) { return print(n, base) + println(); }
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base) { return print(n, base) + println(); }
+size_t Print::println(long long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long long n, int base) { return print(n, base) + println(); }
+size_t Print::println(double n, int digits) { return print(n, digits) + println(); }
+size_t Print::println(const Printable & printable) { return print(printable) + println(); }
+// clang-format on
+
+size_t Print::printNumber(unsigned long long n, uint8_t base) {
+    char buffer[8 * sizeof(n) + 1];
+    char * str = &buffer[sizeof(buffer) - 1];
+    *str       = '\0';
+
+    if (base < 2) {
+        base = 10;
+    }
+
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+
+    return write(str);
+}
+
+size_t Print::printFloat(double number, uint8_t digits) {
+    if (isnan(number)) {
+        return print("nan");
+    }
+
+    if (isinf(number)) {
+        return print("inf");
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, number);
+    return write(buffer);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <Printable.h>
+#include <WString.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: P R I N T : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Same interface as Print from the Arduino SAMD core
+//
+class Print {
+private:
+    int write_error = 0;
+
+    size_t printNumber(unsigned long long n, uint8_t base);
+    size_t printFloat(double number, uint8_t digits);
+
+protected:
+    void setWriteError(int err = 1) {
+        write_error = err;
+    }
+
+public:
+    virtual ~Print() = default;
+
+    int getWriteError() {
+        return write_error;
+    }
+
+    void clearWriteError() {
+        setWriteError(0);
+    }
+
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t * buffer, size_t size);
+
+    size_t write(const char * str) {
+        return str ? write(reinterpret_cast<const uint8_t *>(str), strlen(str)) : 0;
+    }
+
+    size_t write(const char * buffer, size_t size) {
+        return write(reinterpret_cast<const uint8_t *>(buffer), size);
+    }
+
+    virtual int availableForWrite() {
+        return 0;
+    }
+
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper * str);
+    size_t print(const String & str);
+    size_t print(const char str[]);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = DEC);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(long long n, int base = DEC);
+    size_t print(unsigned long long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+    size_t print(const Printable & printable);
+
+    size_t println(const __FlashStringHelper * str);
+    size_t println(const String & str);
+    size_t println(const char str[]);
+    size_t println(char c);
+    size_t println(unsigned char n, int base = DEC);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(long long n, int base = DEC);
+    size_t println(unsigned long long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+    size_t println(const Printable & printable);
+    size_t println();
+};
@@ -0,0 +1,11 @@
+#pragma once
+#include <stddef.h>
+
+class Print;
+
+// Objects that know how to print themselves (same as the Arduino core)
+class Printable {
+public:
+    virtual ~Printable()                          = default;
+    virtual size_t printTo(Print & printer) const = 0;
+};
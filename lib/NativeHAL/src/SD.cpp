@@ -0,0 +1,385 @@
+#include <SD.h>
+#include <NativeHAL.hpp>
+
+#include <algorithm>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+SDClass SD;
+
+namespace {
+    struct Card {
+        std::string root;
+        bool mounted = false;
+        NativeHAL::SDStats stats;
+        NativeHAL::SDTiming timing;
+    };
+
+    Card & card() {
+        static Card instance;
+        return instance;
+    }
+
+    bool hostIsDirectory(const std::string & path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    }
+
+    bool hostExists(const std::string & path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0;
+    }
+
+    std::vector<std::string> listDirectory(const std::string & path) {
+        std::vector<std::string> entries;
+        if (DIR * dir = opendir(path.c_str())) {
+            while (dirent * entry = readdir(dir)) {
+                std::string name = entry->d_name;
+                if (name != "." && name != "..") {
+                    entries.push_back(name);
+                }
+            }
+
+            closedir(dir);
+        }
+
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    void removeTree(const std::string & path) {
+        if (hostIsDirectory(path)) {
+            for (auto & entry : listDirectory(path)) {
+                removeTree(path + "/" + entry);
+            }
+
+            ::rmdir(path.c_str());
+        } else {
+            ::unlink(path.c_str());
+        }
+    }
+
+    bool copyTree(const std::string & from, const std::string & to) {
+        if (hostIsDirectory(from)) {
+            ::mkdir(to.c_str(), 0755);
+            for (auto & entry : listDirectory(from)) {
+                if (!copyTree(from + "/" + entry, to + "/" + entry)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        FILE * src = fopen(from.c_str(), "rb");
+        FILE * dst = fopen(to.c_str(), "wb");
+        bool ok    = src && dst;
+        char buffer[4096];
+        size_t n;
+        while (ok && (n = fread(buffer, 1, sizeof(buffer), src)) > 0) {
+            ok = fwrite(buffer, 1, n, dst) == n;
+        }
+
+        if (src) {
+            fclose(src);
+        }
+
+        if (dst) {
+            fclose(dst);
+        }
+
+        return ok;
+    }
+
+    void charge(unsigned long micros, size_t bytes) {
+        if (micros) {
+            NativeHAL::advanceMicros(uint64_t(micros) * ((bytes + 511) / 512));
+        }
+    }
+}  // namespace
+
+//
+// ─── FILE ───────────────────────────────────────────────────────────────────────
+//
+struct File::Handle {
+    std::string path;
+    std::string name;
+    FILE * fp     = nullptr;
+    bool dir      = false;
+    bool canRead  = true;
+    bool canWrite = false;
+
+    std::vector<std::string> entries;
+    size_t nextEntry = 0;
+
+    ~Handle() {
+        if (fp) {
+            fclose(fp);
+        }
+    }
+};
+
+File::File(const std::string & path, const std::string & name, int mode) {
+    auto h  = std::make_shared<Handle>();
+    h->path = path;
+    h->name = name;
+
+    if (hostIsDirectory(path)) {
+        h->dir     = true;
+        h->entries = listDirectory(path);
+        handle     = h;
+        return;
+    }
+
+    const int access = mode & O_ACCMODE;
+    h->canRead       = access == O_RDONLY || access == O_RDWR;
+    h->canWrite      = access == O_WRONLY || access == O_RDWR;
+
+    const bool found = hostExists(path);
+    if (!found && !(mode & O_CREAT)) {
+        return;
+    }
+
+    if (!h->canWrite) {
+        h->fp = fopen(path.c_str(), "rb");
+    } else if (!found || (mode & O_TRUNC)) {
+        h->fp = fopen(path.c_str(), "w+b");
+    } else {
+        h->fp = fopen(path.c_str(), "r+b");
+    }
+
+    if (!h->fp) {
+        return;
+    }
+
+    // SD library semantics: append mode only moves the initial position to the end,
+    // seek() still works afterward
+    if (mode & O_APPEND) {
+        fseek(h->fp, 0, SEEK_END);
+    }
+
+    handle = h;
+}
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t * buffer, size_t size) {
+    if (!handle || !handle->fp || !handle->canWrite) {
+        setWriteError();
+        return 0;
+    }
+
+    size_t n = fwrite(buffer, 1, size, handle->fp);
+    card().stats.bytesWritten += n;
+    charge(card().timing.sectorWriteMicros, n);
+    return n;
+}
+
+int File::available() {
+    if (!handle || !handle->fp) {
+        return 0;
+    }
+
+    return size() - position();
+}
+
+int File::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::read(void * buffer, uint16_t size) {
+    if (!handle || !handle->fp || !handle->canRead) {
+        return -1;
+    }
+
+    size_t n = fread(buffer, 1, size, handle->fp);
+    card().stats.bytesRead += n;
+    charge(card().timing.sectorReadMicros, n);
+    return n;
+}
+
+int File::peek() {
+    if (!handle || !handle->fp) {
+        return -1;
+    }
+
+    int c = fgetc(handle->fp);
+    if (c != EOF) {
+        ungetc(c, handle->fp);
+    }
+
+    return c == EOF ? -1 : c;
+}
+
+void File::flush() {
+    if (handle && handle->fp) {
+        fflush(handle->fp);
+        card().stats.flushes++;
+    }
+}
+
+bool File::seek(uint32_t position) {
+    return handle && handle->fp && fseek(handle->fp, position, SEEK_SET) == 0;
+}
+
+uint32_t File::position() {
+    return handle && handle->fp ? ftell(handle->fp) : 0;
+}
+
+uint32_t File::size() {
+    if (!handle || !handle->fp) {
+        return 0;
+    }
+
+    fflush(handle->fp);
+    struct stat info;
+    return fstat(fileno(handle->fp), &info) == 0 ? info.st_size : 0;
+}
+
+void File::close() {
+    if (handle && handle->fp) {
+        fclose(handle->fp);
+        handle->fp = nullptr;
+    }
+
+    handle.reset();
+}
+
+const char * File::name() {
+    return handle ? handle->name.c_str() : "";
+}
+
+bool File::isDirectory() {
+    return handle && handle->dir;
+}
+
+File File::openNextFile(int mode) {
+    if (!isDirectory() || handle->nextEntry >= handle->entries.size()) {
+        return File();
+    }
+
+    const auto & name = handle->entries[handle->nextEntry++];
+    return File(handle->path + "/" + name, name, mode);
+}
+
+void File::rewindDirectory() {
+    if (isDirectory()) {
+        handle->entries   = listDirectory(handle->path);
+        handle->nextEntry = 0;
+    }
+}
+
+File::operator bool() {
+    return handle && (handle->dir || handle->fp);
+}
+
+//
+// ─── SD CLASS ───────────────────────────────────────────────────────────────────
+//
+bool SDClass::begin(uint8_t csPin) {
+    return card().mounted;
+}
+
+File SDClass::open(const char * filepath, int mode) {
+    if (!card().mounted) {
+        return File();
+    }
+
+    card().stats.opens++;
+    charge(card().timing.openMicros, 1);
+
+    std::string path = NativeHAL::sdPath(filepath);
+    std::string name = path.substr(path.find_last_of('/') + 1);
+    return File(path, name, mode);
+}
+
+bool SDClass::exists(const char * filepath) {
+    return card().mounted && hostExists(NativeHAL::sdPath(filepath));
+}
+
+bool SDClass::mkdir(const char * filepath) {
+    if (!card().mounted) {
+        return false;
+    }
+
+    // Create intermediate directories like the SD library does
+    std::string path = NativeHAL::sdPath(filepath);
+    for (size_t i = card().root.size() + 1; i <= path.size(); i++) {
+        if (i == path.size() || path[i] == '/') {
+            std::string partial = path.substr(0, i);
+            if (!hostIsDirectory(partial) && ::mkdir(partial.c_str(), 0755) != 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool SDClass::remove(const char * filepath) {
+    return card().mounted && ::unlink(NativeHAL::sdPath(filepath).c_str()) == 0;
+}
+
+bool SDClass::rmdir(const char * filepath) {
+    return card().mounted && ::rmdir(NativeHAL::sdPath(filepath).c_str()) == 0;
+}
+
+//
+// ─── CONTROL SURFACE ────────────────────────────────────────────────────────────
+//
+namespace NativeHAL {
+    bool mountSD(const char * root, const char * templateDir) {
+        std::string path = root;
+        while (path.size() > 1 && path.back() == '/') {
+            path.pop_back();
+        }
+
+        if (templateDir) {
+            removeTree(path);
+            if (!copyTree(templateDir, path)) {
+                return false;
+            }
+        } else if (!hostIsDirectory(path)) {
+            ::mkdir(path.c_str(), 0755);
+        }
+
+        card().root    = path;
+        card().mounted = hostIsDirectory(path);
+        return card().mounted;
+    }
+
+    void unmountSD() {
+        card().mounted = false;
+    }
+
+    std::string sdPath(const char * filepath) {
+        while (*filepath == '/') {
+            filepath++;
+        }
+
+        std::string path = card().root;
+        if (*filepath) {
+            path += "/";
+            path += filepath;
+        }
+
+        while (path.size() > card().root.size() && path.back() == '/') {
+            path.pop_back();
+        }
+
+        return path;
+    }
+
+    SDStats & sdStats() {
+        return card().stats;
+    }
+
+    SDTiming & sdTiming() {
+        return card().timing;
+    }
+}  // namespace NativeHAL
@@ -0,0 +1,92 @@
+#pragma once
+#include <Arduino.h>
+#include <fcntl.h>
+
+#include <memory>
+#include <string>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S D : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Host replacement for the Arduino SD library. The card is a directory on the host that the
+// harness mounts with NativeHAL::mountSD. Open modes use the host <fcntl.h> flags, same as the
+// SdFat flags the firmware passes (O_RDWR | O_CREAT | O_TRUNC).
+//
+#define FILE_READ  O_RDONLY
+#define FILE_WRITE (O_RDWR | O_CREAT | O_APPEND)
+
+class File : public Stream {
+private:
+    struct Handle;
+    std::shared_ptr<Handle> handle;
+
+public:
+    File() = default;
+    File(const std::string & path, const std::string & name, int mode);
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+
+    int read(void * buffer, uint16_t size);
+    bool seek(uint32_t position);
+    uint32_t position();
+    uint32_t size();
+    void close();
+
+    const char * name();
+    bool isDirectory();
+    File openNextFile(int mode = O_RDONLY);
+    void rewindDirectory();
+
+    operator bool();
+};
+
+class SDClass {
+public:
+    bool begin(uint8_t csPin = 10);
+    File open(const char * filepath, int mode = FILE_READ);
+    File open(const String & filepath, int mode = FILE_READ) {
+        return open(filepath.c_str(), mode);
+    }
+
+    bool exists(const char * filepath);
+    bool mkdir(const char * filepath);
+    bool remove(const char * filepath);
+    bool rmdir(const char * filepath);
+};
+
+extern SDClass SD;
+
+namespace NativeHAL {
+    // Use `root` as the SD card. If `templateDir` is given, the card is wiped and populated
+    // with a copy of it (ex: sdcard_template).
+    bool mountSD(const char * root, const char * templateDir = nullptr);
+    void unmountSD();
+    std::string sdPath(const char * filepath);
+
+    struct SDStats {
+        unsigned long opens        = 0;
+        unsigned long bytesRead    = 0;
+        unsigned long bytesWritten = 0;
+        unsigned long flushes      = 0;
+    };
+
+    // Optional cost model. The virtual clock moves forward by these amounts so that the
+    // timing printed by the firmware resembles a real card.
+    struct SDTiming {
+        unsigned long openMicros        = 0;
+        unsigned long sectorReadMicros  = 0;
+        unsigned long sectorWriteMicros = 0;
+    };
+
+    SDStats & sdStats();
+    SDTiming & sdTiming();
+}  // namespace NativeHAL
@@ -0,0 +1,40 @@
+#pragma once
+#include <Arduino.h>
+
+#define SPI_MODE0 0x02
+#define SPI_MODE1 0x00
+#define SPI_MODE2 0x03
+#define SPI_MODE3 0x01
+
+// Host replacement for the SPI library. Nothing is wired to the bus on the host: transfers
+// read back 0xFF like an idle MISO line.
+class SPISettings {
+public:
+    SPISettings() = default;
+    SPISettings(uint32_t clock, BitOrder bitOrder, uint8_t dataMode) {}
+};
+
+class SPIClass {
+public:
+    void begin() {}
+    void end() {}
+    void beginTransaction(SPISettings settings) {}
+    void endTransaction() {}
+    void setBitOrder(BitOrder order) {}
+    void setDataMode(uint8_t mode) {}
+    void setClockDivider(uint8_t divider) {}
+
+    uint8_t transfer(uint8_t data) {
+        return 0xFF;
+    }
+
+    uint16_t transfer16(uint16_t data) {
+        return 0xFFFF;
+    }
+
+    void transfer(void * buffer, size_t count) {
+        memset(buffer, 0xFF, count);
+    }
+};
+
+extern SPIClass SPI;
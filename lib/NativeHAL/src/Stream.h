@@ -0,0 +1,106 @@
+#pragma once
+#include <Print.h>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S T R E A M : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Same interface as Stream from the Arduino SAMD core. Blocking reads never wait on the host:
+// if no data is available, they return immediately.
+//
+class Stream : public Print {
+protected:
+    unsigned long _timeout = 1000;
+
+public:
+    virtual int available() = 0;
+    virtual int read()      = 0;
+    virtual int peek()      = 0;
+
+    void setTimeout(unsigned long timeout) {
+        _timeout = timeout;
+    }
+
+    unsigned long getTimeout() {
+        return _timeout;
+    }
+
+    size_t readBytes(char * buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0) {
+                break;
+            }
+
+            *buffer++ = static_cast<char>(c);
+            count++;
+        }
+
+        return count;
+    }
+
+    size_t readBytes(uint8_t * buffer, size_t length) {
+        return readBytes(reinterpret_cast<char *>(buffer), length);
+    }
+
+    size_t readBytesUntil(char terminator, char * buffer, size_t length) {
+        size_t count = 0;
+        while (count < length) {
+            int c = read();
+            if (c < 0 || c == terminator) {
+                break;
+            }
+
+            *buffer++ = static_cast<char>(c);
+            count++;
+        }
+
+        return count;
+    }
+
+    long parseInt() {
+        return readNumber().toInt();
+    }
+
+    float parseFloat() {
+        return readNumber().toFloat();
+    }
+
+    String readString() {
+        String result;
+        for (int c = read(); c >= 0; c = read()) {
+            result += static_cast<char>(c);
+        }
+
+        return result;
+    }
+
+    String readStringUntil(char terminator) {
+        String result;
+        for (int c = read(); c >= 0 && c != terminator; c = read()) {
+            result += static_cast<char>(c);
+        }
+
+        return result;
+    }
+
+private:
+    // Skip anything that cannot start a number, then collect the number
+    String readNumber() {
+        int c = peek();
+        while (c >= 0 && c != '-' && c != '.' && (c < '0' || c > '9')) {
+            read();
+            c = peek();
+        }
+
+        String number;
+        while (c >= 0 && (c == '-' || c == '.' || (c >= '0' && c <= '9'))) {
+            number += static_cast<char>(read());
+            c = peek();
+        }
+
+        return number;
+    }
+};
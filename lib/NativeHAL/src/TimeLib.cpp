@@ -0,0 +1,149 @@
+#include <TimeLib.h>
+
+namespace {
+    struct SystemTime {
+        time_t sysTime             = 0;
+        unsigned long prevMillis   = 0;
+        time_t nextSyncTime        = 0;
+        time_t syncInterval        = 300;
+        timeStatus_t status        = timeNotSet;
+        getExternalTime getTimePtr = nullptr;
+    };
+
+    SystemTime & systemTime() {
+        static SystemTime instance;
+        return instance;
+    }
+
+    // Days since 1970-01-01 for a proleptic Gregorian date
+    long daysFromCivil(int y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        const long era     = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<long>(doe) - 719468;
+    }
+
+    tmElements_t cached(time_t t) {
+        static time_t cacheTime = -1;
+        static tmElements_t cache;
+        if (t != cacheTime) {
+            breakTime(t, cache);
+            cacheTime = t;
+        }
+
+        return cache;
+    }
+}  // namespace
+
+void breakTime(time_t time, tmElements_t & tm) {
+    const long days = time / SECS_PER_DAY;
+    const long secs = time % SECS_PER_DAY;
+    tm.Second       = secs % 60;
+    tm.Minute       = (secs / 60) % 60;
+    tm.Hour         = secs / 3600;
+    tm.Wday         = ((days + 4) % 7) + 1;  // Sunday is day 1
+
+    // Civil date from days since epoch
+    const long z       = days + 719468;
+    const long era     = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp  = (5 * doy + 2) / 153;
+    const unsigned d   = doy - (153 * mp + 2) / 5 + 1;
+    const unsigned m   = mp < 10 ? mp + 3 : mp - 9;
+    const long y       = static_cast<long>(yoe) + era * 400 + (m <= 2);
+
+    tm.Day   = d;
+    tm.Month = m;
+    tm.Year  = CalendarYrToTm(y);
+}
+
+time_t makeTime(const tmElements_t & tm) {
+    const long days = daysFromCivil(tmYearToCalendar(tm.Year), tm.Month, tm.Day);
+    return days * SECS_PER_DAY + tm.Hour * SECS_PER_HOUR + tm.Minute * SECS_PER_MIN + tm.Second;
+}
+
+time_t now() {
+    auto & c = systemTime();
+    while (millis() - c.prevMillis >= 1000) {
+        c.sysTime++;
+        c.prevMillis += 1000;
+    }
+
+    if (c.nextSyncTime <= c.sysTime && c.getTimePtr) {
+        time_t t = c.getTimePtr();
+        if (t != 0) {
+            setTime(t);
+        } else {
+            c.nextSyncTime = c.sysTime + c.syncInterval;
+            c.status       = c.status == timeNotSet ? timeNotSet : timeNeedsSync;
+        }
+    }
+
+    return c.sysTime;
+}
+
+void setTime(time_t t) {
+    auto & c       = systemTime();
+    c.sysTime      = t;
+    c.nextSyncTime = t + c.syncInterval;
+    c.status       = timeSet;
+    c.prevMillis   = millis();
+}
+
+void setTime(int hr, int min, int sec, int dy, int mnth, int yr) {
+    tmElements_t tm;
+    tm.Year   = yr > 99 ? CalendarYrToTm(yr) : y2kYearToTm(yr);
+    tm.Month  = mnth;
+    tm.Day    = dy;
+    tm.Hour   = hr;
+    tm.Minute = min;
+    tm.Second = sec;
+    setTime(makeTime(tm));
+}
+
+void adjustTime(long adjustment) {
+    systemTime().sysTime += adjustment;
+}
+
+timeStatus_t timeStatus() {
+    now();
+    return systemTime().status;
+}
+
+void setSyncProvider(getExternalTime getTimeFunction) {
+    systemTime().getTimePtr   = getTimeFunction;
+    systemTime().nextSyncTime = systemTime().sysTime;
+    now();
+}
+
+void setSyncInterval(time_t interval) {
+    systemTime().syncInterval = interval;
+    systemTime().nextSyncTime = systemTime().sysTime + interval;
+}
+
+// clang-format off
+int hour() { return hour(now()); }
+int hour(time_t t) { return cached(t).Hour; }
+int hourFormat12() { return hourFormat12(now()); }
+int hourFormat12(time_t t) { int h = hour(t) % 12; return h == 0 ? 12 : h; }
+uint8_t isAM() { return !isPM(now()); }
+uint8_t isAM(time_t t) { return !isPM(t); }
+uint8_t isPM() { return isPM(now()); }
+uint8_t isPM(time_t t) { return hour(t) >= 12; }
+int minute() { return minute(now()); }
+int minute(time_t t) { return cached(t).Minute; }
+int second() { return second(now()); }
+int second(time_t t) { return cached(t).Second; }
+int day() { return day(now()); }
+int day(time_t t) { return cached(t).Day; }
+int weekday() { return weekday(now()); }
+int weekday(time_t t) { return cached(t).Wday; }
+int month() { return month(now()); }
+int month(time_t t) { return cached(t).Month; }
+int year() { return year(now()); }
+int year(time_t t) { return tmYearToCalendar(cached(t).Year); }
+// clang-format on
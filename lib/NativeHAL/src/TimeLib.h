@@ -0,0 +1,79 @@
+#pragma once
+#include <Arduino.h>
+#include <time.h>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: T I M E L I B : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Host replacement for the Arduino Time library (TimeLib.h). System time is derived from
+// millis() so it follows the virtual clock.
+//
+typedef enum { timeNotSet, timeNeedsSync, timeSet } timeStatus_t;
+
+typedef struct {
+    uint8_t Second;
+    uint8_t Minute;
+    uint8_t Hour;
+    uint8_t Wday;  // day of week, sunday is day 1
+    uint8_t Day;
+    uint8_t Month;
+    uint8_t Year;  // offset from 1970
+} tmElements_t, TimeElements, *tmElementsPtr_t;
+
+typedef time_t (*getExternalTime)();
+
+#define tmYearToCalendar(Y) ((Y) + 1970)
+#define CalendarYrToTm(Y)   ((Y) -1970)
+#define tmYearToY2k(Y)      ((Y) -30)
+#define y2kYearToTm(Y)      ((Y) + 30)
+
+#define SECS_PER_MIN  ((time_t) (60UL))
+#define SECS_PER_HOUR ((time_t) (3600UL))
+#define SECS_PER_DAY  ((time_t) (SECS_PER_HOUR * 24UL))
+#define DAYS_PER_WEEK ((time_t) (7UL))
+#define SECS_PER_WEEK ((time_t) (SECS_PER_DAY * DAYS_PER_WEEK))
+#define SECS_PER_YEAR ((time_t) (SECS_PER_DAY * 365UL))
+
+#define numberOfSeconds(_time_) ((_time_) % SECS_PER_MIN)
+#define numberOfMinutes(_time_) (((_time_) / SECS_PER_MIN) % SECS_PER_MIN)
+#define numberOfHours(_time_)   (((_time_) % SECS_PER_DAY) / SECS_PER_HOUR)
+#define dayOfWeek(_time_)       ((((_time_) / SECS_PER_DAY + 4) % DAYS_PER_WEEK) + 1)
+#define elapsedDays(_time_)     ((_time_) / SECS_PER_DAY)
+#define elapsedSecsToday(_time_) ((_time_) % SECS_PER_DAY)
+#define previousMidnight(_time_) (((_time_) / SECS_PER_DAY) * SECS_PER_DAY)
+#define nextMidnight(_time_)     (previousMidnight(_time_) + SECS_PER_DAY)
+
+int hour();
+int hour(time_t t);
+int hourFormat12();
+int hourFormat12(time_t t);
+uint8_t isAM();
+uint8_t isAM(time_t t);
+uint8_t isPM();
+uint8_t isPM(time_t t);
+int minute();
+int minute(time_t t);
+int second();
+int second(time_t t);
+int day();
+int day(time_t t);
+int weekday();
+int weekday(time_t t);
+int month();
+int month(time_t t);
+int year();
+int year(time_t t);
+
+time_t now();
+void setTime(time_t t);
+void setTime(int hr, int min, int sec, int day, int month, int yr);
+void adjustTime(long adjustment);
+
+timeStatus_t timeStatus();
+void setSyncProvider(getExternalTime getTimeFunction);
+void setSyncInterval(time_t interval);
+
+void breakTime(time_t time, tmElements_t & tm);
+time_t makeTime(const tmElements_t & tm);
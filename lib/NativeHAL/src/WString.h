@@ -0,0 +1,134 @@
+#pragma once
+#include <stddef.h>
+#include <stdlib.h>
+#include <string>
+
+// Flash strings live in regular memory on the host
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define PSTR(string_literal) (string_literal)
+#define PROGMEM
+#define PGM_P const char *
+#define pgm_read_byte(addr) (*reinterpret_cast<const unsigned char *>(addr))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define memcpy_P memcpy
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S T R I N G : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Subset of the Arduino String used by ArduinoJson and the framework, backed by std::string
+//
+class String {
+private:
+    std::string buffer;
+
+public:
+    String() = default;
+    String(const char * cstr) : buffer(cstr ? cstr : "") {}
+    String(const std::string & str) : buffer(str) {}
+    String(const __FlashStringHelper * str)
+        : String(reinterpret_cast<const char *>(str)) {}
+    explicit String(char c) : buffer(1, c) {}
+    explicit String(int value) : buffer(std::to_string(value)) {}
+    explicit String(unsigned int value) : buffer(std::to_string(value)) {}
+    explicit String(long value) : buffer(std::to_string(value)) {}
+    explicit String(unsigned long value) : buffer(std::to_string(value)) {}
+    explicit String(double value) : buffer(std::to_string(value)) {}
+
+    const char * c_str() const {
+        return buffer.c_str();
+    }
+
+    unsigned int length() const {
+        return buffer.size();
+    }
+
+    char charAt(unsigned int index) const {
+        return index < buffer.size() ? buffer[index] : 0;
+    }
+
+    char operator[](unsigned int index) const {
+        return charAt(index);
+    }
+
+    bool concat(const char * cstr) {
+        buffer += cstr ? cstr : "";
+        return true;
+    }
+
+    bool concat(const char * cstr, unsigned int size) {
+        buffer.append(cstr, size);
+        return true;
+    }
+
+    bool concat(char c) {
+        buffer += c;
+        return true;
+    }
+
+    bool reserve(unsigned int size) {
+        buffer.reserve(size);
+        return true;
+    }
+
+    String & operator+=(const char * cstr) {
+        concat(cstr);
+        return *this;
+    }
+
+    String & operator+=(char c) {
+        concat(c);
+        return *this;
+    }
+
+    String & operator+=(const String & other) {
+        buffer += other.buffer;
+        return *this;
+    }
+
+    bool operator==(const String & other) const {
+        return buffer == other.buffer;
+    }
+
+    bool operator==(const char * cstr) const {
+        return buffer == (cstr ? cstr : "");
+    }
+
+    bool operator!=(const String & other) const {
+        return !(*this == other);
+    }
+
+    int compareTo(const String & other) const {
+        return buffer.compare(other.buffer);
+    }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        auto index = buffer.find(c, from);
+        return index == std::string::npos ? -1 : static_cast<int>(index);
+    }
+
+    String substring(unsigned int begin) const {
+        return begin < buffer.size() ? String(buffer.substr(begin)) : String();
+    }
+
+    String substring(unsigned int begin, unsigned int end) const {
+        return begin < buffer.size() ? String(buffer.substr(begin, end - begin)) : String();
+    }
+
+    long toInt() const {
+        return strtol(buffer.c_str(), nullptr, 10);
+    }
+
+    float toFloat() const {
+        return strtof(buffer.c_str(), nullptr);
+    }
+
+    friend String operator+(const String & lhs, const String & rhs) {
+        return String(lhs.buffer + rhs.buffer);
+    }
+};
@@ -0,0 +1,98 @@
+#include <WiFi101.h>
+
+#include <deque>
+
+WiFiClass WiFi;
+
+struct WiFiClient::Connection {
+    std::string request;
+    size_t readIndex = 0;
+    bool open        = true;
+};
+
+namespace {
+    struct Network {
+        std::deque<std::shared_ptr<WiFiClient::Connection>> pending;
+        std::string response;
+    };
+
+    Network & network() {
+        static Network instance;
+        return instance;
+    }
+}  // namespace
+
+size_t WiFiClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t * buf, size_t size) {
+    if (!connection || !connection->open) {
+        return 0;
+    }
+
+    network().response.append(reinterpret_cast<const char *>(buf), size);
+    return size;
+}
+
+int WiFiClient::available() {
+    return connection ? connection->request.size() - connection->readIndex : 0;
+}
+
+int WiFiClient::read() {
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t * buf, size_t size) {
+    size_t n = std::min<size_t>(size, available());
+    if (n == 0) {
+        return -1;
+    }
+
+    memcpy(buf, connection->request.data() + connection->readIndex, n);
+    connection->readIndex += n;
+    return n;
+}
+
+int WiFiClient::peek() {
+    return available() ? static_cast<uint8_t>(connection->request[connection->readIndex]) : -1;
+}
+
+void WiFiClient::stop() {
+    if (connection) {
+        connection->open = false;
+    }
+}
+
+uint8_t WiFiClient::connected() {
+    return connection && (connection->open || available());
+}
+
+WiFiClient::operator bool() {
+    return connection && connection->open;
+}
+
+WiFiClient WiFiServer::available(uint8_t * status) {
+    auto & pending = network().pending;
+    if (pending.empty()) {
+        return WiFiClient();
+    }
+
+    auto connection = pending.front();
+    pending.pop_front();
+    network().response.clear();
+    return WiFiClient(connection);
+}
+
+namespace NativeHAL {
+    void wifiRequest(const char * rawRequest) {
+        auto connection     = std::make_shared<WiFiClient::Connection>();
+        connection->request = rawRequest;
+        network().pending.push_back(connection);
+    }
+
+    std::string & wifiResponse() {
+        return network().response;
+    }
+}  // namespace NativeHAL
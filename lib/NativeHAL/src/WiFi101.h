@@ -0,0 +1,193 @@
+#pragma once
+#include <Arduino.h>
+#include <Client.h>
+#include <IPAddress.h>
+#include <Server.h>
+
+#include <memory>
+#include <string>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: W I F I 1 0 1 : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Host replacement for the WiFi101 library. There is no radio: beginAP/begin succeed right
+// away and the server only sees requests queued with NativeHAL::wifiRequest.
+//
+enum wl_status_t {
+    WL_NO_SHIELD       = 255,
+    WL_IDLE_STATUS     = 0,
+    WL_NO_SSID_AVAIL   = 1,
+    WL_SCAN_COMPLETED  = 2,
+    WL_CONNECTED       = 3,
+    WL_CONNECT_FAILED  = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_DISCONNECTED    = 6,
+    WL_AP_LISTENING    = 7,
+    WL_AP_CONNECTED    = 8,
+    WL_AP_FAILED       = 9,
+};
+
+class WiFiClient : public Client {
+public:
+    struct Connection;
+
+private:
+    std::shared_ptr<Connection> connection;
+
+public:
+    WiFiClient() = default;
+    explicit WiFiClient(std::shared_ptr<Connection> connection) : connection(connection) {}
+
+    int connect(IPAddress ip, uint16_t port) override {
+        return 0;
+    }
+
+    int connect(const char * host, uint16_t port) override {
+        return 0;
+    }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t * buf, size_t size) override;
+    using Print::write;
+
+    int available() override;
+    int read() override;
+    int read(uint8_t * buf, size_t size) override;
+    int peek() override;
+    void flush() override {}
+    void stop() override;
+    uint8_t connected() override;
+    operator bool() override;
+
+    IPAddress remoteIP() {
+        return IPAddress(192, 168, 1, 2);
+    }
+
+    uint16_t remotePort() {
+        return 50000;
+    }
+};
+
+class WiFiServer : public Server {
+private:
+    uint16_t port;
+
+public:
+    explicit WiFiServer(uint16_t port) : port(port) {}
+
+    void begin() override {}
+    WiFiClient available(uint8_t * status = nullptr);
+    uint8_t status() {
+        return 1;
+    }
+
+    size_t write(uint8_t c) override {
+        return 1;
+    }
+
+    size_t write(const uint8_t * buf, size_t size) override {
+        return size;
+    }
+
+    using Print::write;
+};
+
+class WiFiClass {
+private:
+    wl_status_t currentStatus = WL_IDLE_STATUS;
+    std::string ssid;
+
+public:
+    void setPins(int8_t cs, int8_t irq, int8_t rst, int8_t en = -1) {}
+
+    uint8_t begin() {
+        return currentStatus = WL_CONNECTED;
+    }
+
+    uint8_t begin(const char * ssid) {
+        this->ssid = ssid;
+        return currentStatus = WL_CONNECTED;
+    }
+
+    uint8_t begin(const char * ssid, const char * passphrase) {
+        return begin(ssid);
+    }
+
+    uint8_t beginAP(const char * ssid) {
+        this->ssid = ssid;
+        return currentStatus = WL_AP_LISTENING;
+    }
+
+    uint8_t beginAP(const char * ssid, uint8_t channel) {
+        return beginAP(ssid);
+    }
+
+    uint8_t beginAP(const char * ssid, const char * key) {
+        return beginAP(ssid);
+    }
+
+    uint8_t beginAP(const char * ssid, const char * key, uint8_t channel) {
+        return beginAP(ssid);
+    }
+
+    void config(IPAddress localIP) {}
+    void hostname(const char * name) {}
+    void setTimeout(unsigned long timeout) {}
+
+    void end() {
+        currentStatus = WL_IDLE_STATUS;
+    }
+
+    void disconnect() {
+        currentStatus = WL_DISCONNECTED;
+    }
+
+    uint8_t status() {
+        return currentStatus;
+    }
+
+    const char * SSID() {
+        return ssid.c_str();
+    }
+
+    int32_t RSSI() {
+        return -40;
+    }
+
+    IPAddress localIP() {
+        return IPAddress(192, 168, 1, 1);
+    }
+
+    IPAddress subnetMask() {
+        return IPAddress(255, 255, 255, 0);
+    }
+
+    IPAddress gatewayIP() {
+        return IPAddress(192, 168, 1, 1);
+    }
+
+    uint8_t * macAddress(uint8_t * mac) {
+        memset(mac, 0, 6);
+        return mac;
+    }
+
+    const char * firmwareVersion() {
+        return "19.6.1";
+    }
+
+    void lowPowerMode() {}
+    void maxLowPowerMode() {}
+    void noLowPowerMode() {}
+};
+
+extern WiFiClass WiFi;
+
+namespace NativeHAL {
+    // Queue a raw HTTP request. The next WiFiServer::available() hands it out as a client.
+    void wifiRequest(const char * rawRequest);
+
+    // Everything written to the client of the most recent request
+    std::string & wifiResponse();
+}  // namespace NativeHAL
@@ -0,0 +1,125 @@
+#include <Wire.h>
+#include <NativeHAL.hpp>
+
+#include <map>
+
+TwoWire Wire;
+
+namespace {
+    struct Bus {
+        std::map<uint8_t, NativeHAL::I2CDevice *> devices;
+        NativeHAL::I2CStats stats;
+        NativeHAL::I2CTiming timing;
+    };
+
+    Bus & bus() {
+        static Bus instance;
+        return instance;
+    }
+
+    NativeHAL::I2CDevice * deviceAt(uint8_t address) {
+        auto found = bus().devices.find(address);
+        return found == bus().devices.end() ? nullptr : found->second;
+    }
+
+    void charge(size_t bytes) {
+        bus().stats.bytes += bytes;
+        if (bus().timing.byteMicros) {
+            // Address byte plus payload
+            NativeHAL::advanceMicros(uint64_t(bus().timing.byteMicros) * (bytes + 1));
+        }
+    }
+}  // namespace
+
+void TwoWire::beginTransmission(uint8_t address) {
+    txAddress    = address;
+    transmitting = true;
+    txBuffer.clear();
+}
+
+// Same return codes as the Arduino core: 0 success, 2 address NACK, 3 data NACK
+uint8_t TwoWire::endTransmission(bool stopBit) {
+    if (!transmitting) {
+        return 0;
+    }
+
+    transmitting = false;
+    bus().stats.writes++;
+    charge(txBuffer.size());
+
+    auto device = deviceAt(txAddress);
+    if (!device) {
+        bus().stats.nacks++;
+        return 2;
+    }
+
+    return device->receive(txBuffer.data(), txBuffer.size()) ? 0 : 3;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit) {
+    rxBuffer.assign(quantity, 0);
+    rxIndex = 0;
+    bus().stats.reads++;
+
+    auto device = deviceAt(address);
+    if (!device) {
+        bus().stats.nacks++;
+        rxBuffer.clear();
+        charge(0);
+        return 0;
+    }
+
+    size_t received = std::min(device->request(rxBuffer.data(), quantity), quantity);
+    rxBuffer.resize(received);
+    charge(received);
+    return received;
+}
+
+size_t TwoWire::write(uint8_t data) {
+    if (!transmitting) {
+        return 0;
+    }
+
+    txBuffer.push_back(data);
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t * data, size_t quantity) {
+    for (size_t i = 0; i < quantity; i++) {
+        if (!write(data[i])) {
+            return i;
+        }
+    }
+
+    return quantity;
+}
+
+int TwoWire::available() {
+    return rxBuffer.size() - rxIndex;
+}
+
+int TwoWire::read() {
+    return rxIndex < rxBuffer.size() ? rxBuffer[rxIndex++] : -1;
+}
+
+int TwoWire::peek() {
+    return rxIndex < rxBuffer.size() ? rxBuffer[rxIndex] : -1;
+}
+
+namespace NativeHAL {
+    void attachI2CDevice(uint8_t address, I2CDevice * device) {
+        bus().devices[address] = device;
+    }
+
+    void detachI2CDevice(uint8_t address) {
+        bus().devices.erase(address);
+    }
+
+    I2CStats & i2cStats() {
+        return bus().stats;
+    }
+
+    I2CTiming & i2cTiming() {
+        return bus().timing;
+    }
+}  // namespace NativeHAL
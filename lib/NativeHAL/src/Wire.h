@@ -0,0 +1,93 @@
+#pragma once
+#include <Arduino.h>
+
+#include <functional>
+#include <vector>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: W I R E : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Host replacement for the SAMD Wire library. Transactions are routed to devices that the
+// harness attaches with NativeHAL::attachI2CDevice. Addresses without a device NACK and
+// reads from them return no data, same as an empty bus.
+//
+class TwoWire : public Stream {
+private:
+    uint8_t txAddress = 0;
+    std::vector<uint8_t> txBuffer;
+    std::vector<uint8_t> rxBuffer;
+    size_t rxIndex    = 0;
+    bool transmitting = false;
+
+public:
+    void begin() {}
+    void begin(uint8_t address) {}
+    void end() {}
+    void setClock(uint32_t frequency) {}
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool stopBit = true);
+
+    uint8_t requestFrom(uint8_t address, size_t quantity, bool stopBit = true);
+
+    size_t write(uint8_t data) override;
+    size_t write(const uint8_t * data, size_t quantity) override;
+    using Print::write;
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override {}
+};
+
+extern TwoWire Wire;
+
+namespace NativeHAL {
+    // A device on the I2C bus. Both methods run synchronously inside the Wire call.
+    class I2CDevice {
+    public:
+        virtual ~I2CDevice() = default;
+
+        // Master wrote `size` bytes. Return false to NACK.
+        virtual bool receive(const uint8_t * data, size_t size) = 0;
+
+        // Master requested up to `quantity` bytes. Return the number of bytes provided.
+        virtual size_t request(uint8_t * buffer, size_t quantity) = 0;
+    };
+
+    // Device defined by two callbacks. Handy for scripted responses in tests.
+    class ScriptedI2CDevice : public I2CDevice {
+    public:
+        std::function<bool(const uint8_t *, size_t)> onReceive;
+        std::function<size_t(uint8_t *, size_t)> onRequest;
+
+        bool receive(const uint8_t * data, size_t size) override {
+            return onReceive ? onReceive(data, size) : true;
+        }
+
+        size_t request(uint8_t * buffer, size_t quantity) override {
+            return onRequest ? onRequest(buffer, quantity) : 0;
+        }
+    };
+
+    void attachI2CDevice(uint8_t address, I2CDevice * device);
+    void detachI2CDevice(uint8_t address);
+
+    struct I2CStats {
+        unsigned long writes = 0;  // endTransmission calls
+        unsigned long reads  = 0;  // requestFrom calls
+        unsigned long nacks  = 0;  // transactions to an address without a device
+        unsigned long bytes  = 0;  // bytes moved in both directions
+    };
+
+    // Optional cost model: the virtual clock moves by byteMicros for every byte on the bus
+    // (~90 us per byte at 100 kHz including the ACK bit)
+    struct I2CTiming {
+        unsigned long byteMicros = 0;
+    };
+
+    I2CStats & i2cStats();
+    I2CTiming & i2cTiming();
+}  // namespace NativeHAL
@@ -0,0 +1,18 @@
+#include <Arduino.h>
+
+// Runs the firmware's setup()/loop() when no other main() is linked in (ex: `pio run -e native`).
+// Test harnesses provide their own main() and this object file is never pulled from the archive.
+void setup() __attribute__((weak));
+void loop() __attribute__((weak));
+
+int main() {
+    if (setup) {
+        setup();
+    }
+
+    while (loop) {
+        loop();
+    }
+
+    return 0;
+}
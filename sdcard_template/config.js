@@ -26,8 +26,10 @@
 		23
     ],
     "logFile": "log.csv",
+    "packedValveTable": false,
     "statusFile": "status.js",
     "taskFolder": "tasks",
     "valveFolder": "valves",
-    "valveUpperBound": 23
+    "valveUpperBound": 23,
+    "wifiWindows": []
 }
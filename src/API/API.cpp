@@ -1,4 +1,5 @@
 #include <Application/App.hpp>
+#include <Utilities/Log.hpp>
 
 namespace API {
     auto StartHyperFlush::operator()(App & app) -> R {
@@ -20,7 +21,7 @@ namespace API {
         decltype(auto) nowTaskName = app.nowTaskStateController.getCurrentState()->getName();
 
         R response;
-        if (strcmp(NowT::IDLE, nowTaskName) == 0) {
+        if (strcmp(Pipeline::IDLE, nowTaskName) == 0) {
             app.beginNowTask();
             response["success"] = "Beginning Now Task";
         } else {
@@ -66,9 +67,9 @@ namespace API {
         strcpy(task.name, name);
         app.tm.insertTask(task, true);
 
-        // NOTE: Uncomment to save task. Not sure if this is necessary here.
-        // Current behaviour requires the user to "save" the task first before writing to SD card.
-        // tm.writeToDirectory();
+        // NOTE: The create is only journaled once the user "saves" the task. Uncomment to
+        // persist it immediately.
+        // tm.writeChangesToJournal();
 
         // Success response
         KPStringBuilder<100> success("Successfully created ", name);
@@ -78,8 +79,11 @@ namespace API {
         JsonVariant payload = response.createNestedObject("payload");
         encodeJSON(task, payload);
 
-        println(measureJson(response));
-        serializeJsonPretty(response, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            println(measureJson(response));
+            serializeJsonPretty(response, Serial);
+        }
+
         return response;
     }
 
@@ -100,8 +104,15 @@ namespace API {
 
     auto TaskSave::operator()(Arg<0> & app, Arg<1> & input) -> R {
         R response;
-        // Prarse incomming payload
-        Task incomingTask;
+        const int id = input[TaskKeys::ID];
+        if (!app.tm.findTask(id)) {
+            response["error"] = "Task not found";
+            return response;
+        }
+
+        // Prarse incomming payload on top of the stored task so that keys missing from the
+        // payload (ex: repeat, pipeline) keep their values
+        Task incomingTask = app.tm.tasks[id];
         incomingTask.decodeJSON(input.as<JsonVariant>());
 
         // Validate
@@ -111,8 +122,8 @@ namespace API {
         }
 
         // Save
-        app.tm.tasks[incomingTask.id] = incomingTask;
-        app.tm.writeToDirectory();
+        app.tm.updateTask(incomingTask);
+        app.tm.writeChangesToJournal();
 
         response["success"] = "Task successfully saved";
         return response;
@@ -149,7 +160,7 @@ namespace API {
         }
 
         app.tm.deleteTask(id);
-        app.tm.writeToDirectory();
+        app.tm.writeChangesToJournal();
         response["success"] = "Task deleted";
         return response;
     }
@@ -165,8 +176,10 @@ namespace API {
 
         Task & task           = app.tm.tasks[id];
         task.valveOffsetStart = 0;
+        task.repeat.done      = 0;
+        app.tm.markTaskAsModified(task.id);
         app.tm.setTaskStatus(task.id, TaskStatus::active);
-        app.tm.writeToDirectory();
+        app.tm.writeChangesToJournal();
 
         JsonVariant payload = response.createNestedObject("payload");
         encodeJSON(task, payload);
@@ -193,7 +206,7 @@ namespace API {
             app.taskStateController.stop();
         } else {
             app.invalidateTaskAndFreeUpValves(task);
-            app.tm.writeToDirectory();
+            app.tm.writeChangesToJournal();
         }
 
         JsonVariant payload = response.createNestedObject("payload");
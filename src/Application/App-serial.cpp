@@ -117,6 +117,65 @@ void App::setupSerialRouting() {
             return;
         }
 
+        if (strcmp(endpoint, "log") == 0) {
+            decltype(auto) stats = detailLog.stats;
+            println(detailLog.filepath, ": ", stats.rows, " rows, ", stats.bytes, " bytes, ",
+                    stats.flushes, " SD flushes");
+            endTransmission();
+            return;
+        }
+
+#ifdef PERF_PROFILER
+        if (strcmp(endpoint, "perf") == 0) {
+            profiler.print();
+            endTransmission();
+            return;
+        }
+#endif
+
+        if (strcmp(endpoint, "shift") == 0) {
+            shift.printStats();
+            endTransmission();
+            return;
+        }
+
+        // query tasks [status|all] [offset] [limit] [field,field,...]
+        if (strcmp(endpoint, "tasks") == 0) {
+            TaskQuery query;
+            if (args.size() > 2 && !query.selectStatus(args[2].c_str())) {
+                println(RED("Unknown task status "), args[2].c_str());
+            }
+
+            query.offset = args.size() > 3 && is_number(args[3]) ? std::stoul(args[3]) : 0;
+            query.limit  = args.size() > 4 && is_number(args[4]) ? std::stoul(args[4]) : 0;
+            for (size_t start = 0; args.size() > 5 && start < args[5].size();) {
+                const size_t end = std::min(args[5].find(',', start), args[5].size());
+                const std::string field = args[5].substr(start, end - start);
+                if (!query.select(field.c_str())) {
+                    println(RED("Unknown task field "), field.c_str());
+                }
+
+                start = end + 1;
+            }
+
+            println(tm.countMatching(query), " matching task(s)");
+            tm.streamJSON(Serial, query);
+            endTransmission();
+            return;
+        }
+
+        if (strcmp(endpoint, "boot") == 0) {
+            BootProfile::printHistory();
+            endTransmission();
+            return;
+        }
+
+        if (strcmp(endpoint, "wake") == 0) {
+            power.printWakePlan();
+            endTransmission();
+            return;
+        }
+
         if(strcmp(endpoint, "time") == 0) {
             power.printCurrentTime();
             return;
@@ -124,7 +183,7 @@ void App::setupSerialRouting() {
 
         if (strcmp(endpoint, "sensors") == 0) {
             if(sensors.pressure.enabled){
-                println("Pressure sensor detected");
+                println("Pressure sensor detected, stale reads: ", sensors.pressure.staleReads);
             } else {
                 println(RED("Pressure sensor not detected"));
             }
@@ -142,6 +201,22 @@ void App::setupSerialRouting() {
         }
     };
 
+    mapNameToCallback["wifi"] = [this](std::vector<std::string> args) {
+        if (args.size() > 1 && args[1] == "on") {
+            wifiRequested = "serial command";
+            if (isRunningTask()) {
+                println("WiFi will start at the end of the current task");
+            }
+
+            return;
+        }
+
+        println("WiFi ", wifiStarted ? "on" : "off", ", ", config.numberOfWiFiWindows,
+                " maintenance window(s), ", config.isWithinWiFiWindow(now()) ? "inside" : "outside",
+                " one now");
+        endTransmission();
+    };
+
     mapNameToCallback["alarm"] = [this](std::vector<std::string> args) {
         long time = std::labs(std::stol(args[1]));
         power.scheduleNextAlarm(time + now());
@@ -163,6 +238,15 @@ void App::setupSerialRouting() {
             endTransmission();
             return;
         }
+
+#ifdef PERF_PROFILER
+        if (strcmp(endpoint, "perf") == 0) {
+            profiler.reset();
+            println("Loop profiler reset");
+            endTransmission();
+            return;
+        }
+#endif
     };
 }
 
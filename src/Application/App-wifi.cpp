@@ -1,16 +1,31 @@
 #include <Application/App.hpp>
+#include <Utilities/ChunkedResponse.hpp>
+#include <Utilities/ETag.hpp>
+#include <Utilities/Log.hpp>
+
+namespace {
+    // Answer with 304 if the client already has this version of the resource
+    bool sendIfNotModified(Request & req, Response & res, const ETag & etag) {
+        if (!etag.isMatchedBy(req.header)) {
+            return false;
+        }
+
+        etag.sendNotModified(res.client);
+        res.end();
+        return true;
+    }
+}  // namespace
 
 void App::setupServerRouting() {
-    server.handlers.reserve(13);
+    server.handlers.reserve(23);  // One per route below
 
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Web UI, brotli if the browser accepts it. Answered with 304 when the browser
+    // already has the current bundle.
+    // ────────────────────────────────────────────────────────────────────────────────
     server.get("/", [this](Request & req, Response & res) {
-        if (strstr(req.header, "br")) {
-            res.setHeader("Content-Encoding", "br");
-            res.sendFile("index.br", fileLoader);
-        } else {
-            res.setHeader("Content-Encoding", "gzip");
-            res.sendFile("index.gz", fileLoader);
-        }
+        StaticAsset & asset = strstr(req.header, "br") && webUI[0].isLoaded() ? webUI[0] : webUI[1];
+        asset.send(res.client, req.header);
         res.end();
     });
 
@@ -27,56 +42,152 @@ void App::setupServerRouting() {
     });
 
     // ────────────────────────────────────────────────────────────────────────────────
-    // Get the current status
+    // Get the current status. Not cached: it holds the time and live readings, which
+    // /api/events pushes as they change.
     // ────────────────────────────────────────────────────────────────────────────────
     server.get("/api/status", [this](Request &, Response & res) {
         const auto & response = dispatchAPI<API::StatusGet>();
 
+        KPStringBuilder<10> length(measureJson(response));
+        res.setHeader("Content-Length", length);
+        res.setHeader("Cache-Control", "no-store");
+        res.json(response);
+        res.end();
+
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(response, Serial);
+        }
+    });
+
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Stream status changes as server-sent events. The connection is kept by the event
+    // stream, so the response is not ended here.
+    // ────────────────────────────────────────────────────────────────────────────────
+    server.get("/api/events", [this](Request &, Response & res) {
+        if (!events.add(res.client)) {
+            res.client.print("HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\n\r\n");
+            res.end();
+        }
+    });
+
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Get the time spent in each phase of the last boots
+    // ────────────────────────────────────────────────────────────────────────────────
+    server.get("/api/boot", [this](Request &, Response & res) {
+        StaticJsonDocument<BootProfile::encodingSize()> response;
+        BootProfile::encodeJSON(response.to<JsonArray>());
+
         KPStringBuilder<10> length(measureJson(response));
         res.setHeader("Content-Length", length);
         res.json(response);
         res.end();
+    });
 
-        serializeJsonPretty(response, Serial);
+#ifdef PERF_PROFILER
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Get per-component loop timing
+    // ────────────────────────────────────────────────────────────────────────────────
+    server.get("/api/perf", [this](Request &, Response & res) {
+        StaticJsonDocument<decltype(profiler)::encodingSize()> response;
+        profiler.encodeJSON(response.to<JsonArray>());
+
+        KPStringBuilder<10> length(measureJson(response));
+        res.setHeader("Content-Length", length);
+        res.json(response);
+        res.end();
+    });
+
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Clear the loop timing collected so far
+    // ────────────────────────────────────────────────────────────────────────────────
+    server.post("/api/perf/reset", [this](Request &, Response & res) {
+        profiler.reset();
+        res.end();
     });
+#endif
 
     // ────────────────────────────────────────────────────────────────────────────────
     // Get a list of valve objects
     // ────────────────────────────────────────────────────────────────────────────────
-    server.get("/api/valves", [this](Request &, Response & res) {
+    server.get("/api/valves", [this](Request & req, Response & res) {
+        const ETag etag(startTime, vm.version());
+        if (sendIfNotModified(req, res, etag)) {
+            return;
+        }
+
         StaticJsonDocument<ValveManager::encodingSize()> response;
         encodeJSON(vm, response.to<JsonArray>());
 
         KPStringBuilder<10> length(measureJson(response));
         res.setHeader("Content-Length", length);
+        res.setHeader("ETag", etag);
         res.json(response);
         res.end();
     });
 
     // ────────────────────────────────────────────────────────────────────────────────
-    // Get a list of task objects
+    // Get the config
     // ────────────────────────────────────────────────────────────────────────────────
-    server.get("/api/tasks", [this](Request &, Response & res) {
-        StaticJsonDocument<TaskManager::encodingSize()> response;
-        encodeJSON(tm, response.to<JsonArray>());
+    server.get("/api/config", [this](Request & req, Response & res) {
+        const ETag etag(startTime, config.version);
+        if (sendIfNotModified(req, res, etag)) {
+            return;
+        }
+
+        const auto & response = dispatchAPI<API::ConfigGet>();
 
         KPStringBuilder<10> length(measureJson(response));
         res.setHeader("Content-Length", length);
+        res.setHeader("ETag", etag);
         res.json(response);
         res.end();
     });
 
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Get a list of task objects
+    // ────────────────────────────────────────────────────────────────────────────────
+    server.get("/api/tasks", [this](Request & req, Response & res) {
+        const ETag etag(startTime, tm.version());
+        if (sendIfNotModified(req, res, etag)) {
+            return;
+        }
+
+        KPStringBuilder<40> headers("ETag: ", static_cast<const char *>(etag), "\r\n");
+        ChunkedResponse<ProgramSettings::HTTP_CHUNK_SIZE> body(res.client);
+        body.begin("application/json", headers);
+        tm.streamJSON(body);
+        body.end();
+        res.end();
+    });
+
+    // ────────────────────────────────────────────────────────────────────────────────
+    // Get a page of tasks with the given status, optionally only some of their fields.
+    // X-Total-Count is the number of tasks with that status. See TaskQuery.
+    // ────────────────────────────────────────────────────────────────────────────────
+    server.post("/api/tasks/query", [this](Request & req, Response & res) {
+        StaticJsonDocument<300> body;
+        deserializeJson(body, req.body);
+
+        TaskQuery query;
+        query.decodeJSON(body.as<JsonVariantConst>());
+
+        KPStringBuilder<40> total("X-Total-Count: ", tm.countMatching(query), "\r\n");
+        ChunkedResponse<ProgramSettings::HTTP_CHUNK_SIZE> response(res.client);
+        response.begin("application/json", total);
+        tm.streamJSON(response, query);
+        response.end();
+        res.end();
+    });
+
     // ────────────────────────────────────────────────────────────────────────────────
     // Get now task object
     // ────────────────────────────────────────────────────────────────────────────────
     server.get("/api/nowtask", [this](Request &, Response & res) {
-        println(BLUE("REQUESTING NOW TASK"));
-        StaticJsonDocument<TaskManager::encodingSize()> response;
-        encodeJSON(ntm, response.to<JsonArray>());
-
-        KPStringBuilder<10> length(measureJson(response));
-        res.setHeader("Content-Length", length);
-        res.json(response);
+        LOG_DEBUG(api, "GET /api/nowtask");
+        ChunkedResponse<ProgramSettings::HTTP_CHUNK_SIZE> body(res.client);
+        body.begin();
+        ntm.streamJSON(body);
+        body.end();
         res.end();
     });
 
@@ -86,7 +197,9 @@ void App::setupServerRouting() {
     server.post("/api/task/get", [this](Request & req, Response & res) {
         StaticJsonDocument<Task::encodingSize()> body;
         deserializeJson(body, req.body);
-        serializeJsonPretty(body, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(body, Serial);
+        }
 
         const auto & response = dispatchAPI<API::TaskGet>(body);
         res.json(response);
@@ -99,11 +212,15 @@ void App::setupServerRouting() {
     server.post("/api/task/create", [this](Request & req, Response & res) {
         StaticJsonDocument<100> body;
         deserializeJson(body, req.body);
-        serializeJsonPretty(body, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(body, Serial);
+        }
 
         const auto & response = dispatchAPI<API::TaskCreate>(body);
         res.json(response);
-        serializeJsonPretty(response, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(response, Serial);
+        }
         res.end();
     });
 
@@ -113,7 +230,9 @@ void App::setupServerRouting() {
     server.post("/api/task/save", [this](Request & req, Response & res) {
         StaticJsonDocument<Task::encodingSize()> body;
         deserializeJson(body, req.body);
-        serializeJsonPretty(body, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(body, Serial);
+        }
 
         const auto & response = dispatchAPI<API::TaskSave>(body);
         res.json(response);
@@ -124,10 +243,12 @@ void App::setupServerRouting() {
     // Update existing task with incoming data
     // ────────────────────────────────────────────────────────────────────────────────
     server.post("/api/nowtask/save", [this](Request & req, Response & res) {
-        println(BLUE("SAVING NOW TASK"));
+        LOG_DEBUG(api, "POST /api/nowtask/save");
         StaticJsonDocument<Task::encodingSize()> body;
         deserializeJson(body, req.body);
-        serializeJsonPretty(body, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(body, Serial);
+        }
 
         const auto & response = dispatchAPI<API::NowTaskSave>(body);
         res.json(response);
@@ -139,7 +260,9 @@ void App::setupServerRouting() {
     server.post("/api/task/schedule", [this](Request & req, Response & res) {
         StaticJsonDocument<100> body;
         deserializeJson(body, req.body);
-        serializeJsonPretty(body, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(body, Serial);
+        }
 
         const auto & response = dispatchAPI<API::TaskSchedule>(body);
         res.json(response);
@@ -152,7 +275,9 @@ void App::setupServerRouting() {
     server.post("/api/task/unschedule", [this](Request & req, Response & res) {
         StaticJsonDocument<100> body;
         deserializeJson(body, req.body);
-        serializeJsonPretty(body, Serial);
+        if (LOG_ENABLED(debug, api)) {
+            serializeJsonPretty(body, Serial);
+        }
 
         const auto & response = dispatchAPI<API::TaskUnschedule>(body);
         res.json(response);
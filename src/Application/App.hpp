@@ -11,6 +11,9 @@
 #include <Application/Constants.hpp>
 #include <Application/Status.hpp>
 #include <Application/ScheduleReturnCode.hpp>
+#include <Application/BootSnapshot.hpp>
+#include <Application/BootProfile.hpp>
+#include <Application/EventStream.hpp>
 
 #include <Components/Pump.hpp>
 #include <Components/ShiftRegister.hpp>
@@ -18,8 +21,9 @@
 #include <Components/NowSampleButton.hpp>
 #include <Components/SensorArray.hpp>
 #include <Components/Intake.hpp>
+#include <Components/Actuator.hpp>
 
-#include <StateControllers/TaskStateController.hpp>
+#include <StateControllers/PipelineStateController.hpp>
 #include <StateControllers/HyperFlushStateController.hpp>
 #include <StateControllers/DebubbleStateController.hpp>
 
@@ -33,6 +37,9 @@
 #include <Task/NowTaskManager.hpp>
 
 #include <Utilities/JsonEncodableDecodable.hpp>
+#include <Utilities/BlockLogWriter.hpp>
+#include <Utilities/LoopProfiler.hpp>
+#include <Utilities/StaticAsset.hpp>
 
 #include <API/API.hpp>
 
@@ -55,10 +62,8 @@ public:
         HardwarePins::MOTOR_REVERSE,
     };
 
-    const int numberOfRegisters = 4;
     ShiftRegister shift{
         "shift-register",
-        numberOfRegisters,
         HardwarePins::SHFT_REG_DATA,
         HardwarePins::SHFT_REG_CLOCK,
         HardwarePins::SHFT_REG_LATCH,
@@ -67,13 +72,14 @@ public:
     Power power{"power"};
     NowSampleButton nowSampleButton{"nowSampleButton"};
     BallIntake intake{shift};
+    Actuator actuator{"actuator", shift, pump, intake};
     Config config{ProgramSettings::CONFIG_FILE_PATH};
     Status status;
 
     // MainStateController sm;
-    TaskStateController taskStateController;
+    PipelineStateController taskStateController{"new-state-controller"};
     HyperFlushStateController hyperFlushStateController;
-    NowTaskStateController nowTaskStateController;
+    PipelineStateController nowTaskStateController{"nowtask-state-controller"};
     DebubbleStateController debubbleStateController;
 
     ValveManager vm;
@@ -81,10 +87,30 @@ public:
     NowTaskManager ntm;
 
     SensorArray sensors{"sensor-array"};
+    BlockLogWriter<ProgramSettings::DETAIL_LOG_BUFFER_SIZE> detailLog{
+        ProgramSettings::DETAIL_LOG_FILE};
 
     int currentTaskId = 0;
     bool sampleNowActive = false;
 
+    BootProfile bootProfile;
+    unsigned long startTime = 0;  // RTC time at boot, part of every ETag
+    EventStream events{"events", status};
+    StaticAsset webUI[2]{{"index.br", "br"}, {"index.gz", "gzip"}};  // Loaded by startWiFi
+
+    bool wifiStarted           = false;
+    const char * wifiRequested = nullptr;  // Reason, served by update() outside the component loop
+
+#ifdef PERF_PROFILER
+    LoopProfiler<ProgramSettings::PROFILED_COMPONENTS> profiler;
+
+    // Shadows KPController::addComponent so that every component is also profiled
+    void addComponent(KPComponent & component) {
+        KPController::addComponent(component);
+        profiler.track(component);
+    }
+#endif
+
 private:
     const char * KPSerialInputObserverName() const override {
         return "Application-KPSerialInput Observer";
@@ -109,6 +135,7 @@ public:
         println(BLUE("                   DEBUG MODE"));
         println(BLUE("=================================================="));
 #endif
+        bootProfile.begin();
 
         //
         // ─── POWER MODULE ────────────────────────────────────────────────
@@ -116,15 +143,13 @@ public:
         // Here we add and initialize the power module first.
         // So we can seed the random number generator with actual time from RTC.
         addComponent(power);
-        randomSeed(now());
+        startTime = now();
+        randomSeed(startTime);
+        bootProfile.mark(BootProfile::rtc);
 
-        //
-        // ─── ADD WIFI SERVER ─────────────────────────────────────────────
-        //
-
-        addComponent(server);
-        server.begin();
-        setupServerRouting();
+        // The WINC1500 stays powered down until startWiFi, see wifiStartReason
+        pinMode(HardwarePins::WIFI_ENABLE, OUTPUT);
+        digitalWrite(HardwarePins::WIFI_ENABLE, LOW);
 
         //
         // ─── ADDING COMPONENTS ───────────────────────────────────────────
@@ -135,21 +160,34 @@ public:
 
         addComponent(ActionScheduler::sharedInstance());
         addComponent(fileLoader);
+        power.loadWakeLog();
+        bootProfile.mark(BootProfile::sd);
+
         addComponent(shift);
         addComponent(pump);
+        addComponent(actuator);
         addComponent(sensors);
         sensors.addObserver(status);
         addComponent(nowSampleButton);
-
-
+        bootProfile.mark(BootProfile::components);
 
         //
         // ─── LOADING CONFIG FILE ─────────────────────────────────────────
         //
-        // Load configuration from file to initialize config and status objects
-        JsonFileLoader loader;
-        loader.load(config.configFilepath, config);
+        // Load configuration from file to initialize config and status objects. The snapshot
+        // written at the last shutdown, if still valid, replaces every JSON file below except
+        // the now task.
+        BootSnapshot snapshot;
+        const bool restored = snapshot.load(config.configFilepath);
+        if (restored) {
+            snapshot.restore(config);
+        } else {
+            JsonFileLoader loader;
+            loader.load(config.configFilepath, config);
+        }
+
         status.init(config);
+        bootProfile.mark(BootProfile::config);
 
         //
         // ─── ADDING VALVE MANAGER ────────────────────────────────────────
@@ -157,7 +195,13 @@ public:
 
         vm.init(config);
         vm.addObserver(status);
-        vm.loadValvesFromDirectory(config.valveFolder);
+        if (restored) {
+            snapshot.restore(vm);
+        } else {
+            vm.loadValvesFromDirectory(config.valveFolder);
+        }
+
+        bootProfile.mark(BootProfile::valves);
 
         //
         // ─── ADDING TASK MANAGER ─────────────────────────────────────────
@@ -165,8 +209,13 @@ public:
 
         tm.init(config);
         tm.addObserver(this);
-        tm.loadTasksFromDirectory(config.taskFolder);
+        if (restored) {
+            snapshot.restore(tm);
+        } else {
+            tm.loadTasksFromDirectory(config.taskFolder);
+        }
 
+        bootProfile.mark(BootProfile::tasks);
 
         //
         // ___ ADDING NOW TASK MANAGER _____________________________________
@@ -175,6 +224,7 @@ public:
         ntm.init(config);
         ntm.addObserver(this);
         ntm.loadTasksFromDirectory(config.taskFolder);
+        bootProfile.mark(BootProfile::nowTask);
         //pinMode(LED_BUILTIN, OUTPUT);
         //
         // ─── HYPER FLUSH CONTROLLER ──────────────────────────────────────
@@ -213,15 +263,21 @@ public:
         addComponent(taskStateController);
         taskStateController.addObserver(status);
         taskStateController.idle();  // Wait in IDLE
+        bootProfile.mark(BootProfile::controllers);
 
-        // Print WiFi status
-        if (server.enabled()) {
-            println();
-            println(BLUE("====================== WIFI ======================"));
-            server.printWiFiStatus();
-            println(BLUE("=================================================="));
+        //
+        // ─── ADD WIFI SERVER ─────────────────────────────────────────────
+        //
+
+        setupServerRouting();
+        if (const char * reason = wifiStartReason()) {
+            startWiFi(reason);
+        } else {
+            println(BLUE("WiFi off: woken by RTC alarm outside of maintenance windows"));
         }
 
+        bootProfile.mark(BootProfile::server);
+
         // Regular log header
         if (!SD.exists(config.logFile)) {
             File file = SD.open(config.logFile, FILE_WRITE);
@@ -234,8 +290,8 @@ public:
         }
 
         // Detail log header
-        if (!SD.exists("detail.csv")) {
-            File file = SD.open("detail.csv", FILE_WRITE);
+        if (!SD.exists(ProgramSettings::DETAIL_LOG_FILE)) {
+            File file = SD.open(ProgramSettings::DETAIL_LOG_FILE, FILE_WRITE);
             KPStringBuilder<404> header{"UTC, Formatted Time, Task Name, Valve Number, Current "
                                         "State, Config Sample Time, Config Sample "
                                         "Pressure, Config Sample Volume, Temperature Recorded,"
@@ -256,20 +312,38 @@ public:
              if(!power.rtc.alarm(1) && !power.rtc.alarm(2)){
                 println(GREEN("Sample Now Button Interrupted!"));
                 println(beginNowTask().description());
+                wifiRequested = "button press";
              }
             interrupts();
         });
-        runForever(1000, "detailLog", [&]() { logDetail("detail.csv"); });
+        runForever(1000, "detailLog", [&]() { logDetail(); });
+        runForever(ProgramSettings::WIFI_WINDOW_CHECK_PERIOD, "wifiWindow", [&]() {
+            if (!wifiStarted && config.isWithinWiFiWindow(now())) {
+                wifiRequested = "maintenance window";
+            }
+        });
 #if defined(DEBUG)
         runForever(2000, "memLog", [&]() { printFreeRam(); });
 #endif
+
+        bootProfile.mark(BootProfile::logs);
+        bootProfile.current.snapshot = restored;
+        bootProfile.save();
+        println(GREEN("Boot"), " took ", BootProfile::total(bootProfile.current), " ms",
+                restored ? " (state restored from snapshot)" : "");
     }
 
-    void logDetail(const char * filename) {
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Append a row of the current sensor readings to the detail log. Rows are
+     *  buffered by detailLog and reach the SD card one sector at a time.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void logDetail() {
         if (currentTaskId) {
-            SD.begin(HardwarePins::SD_CARD);
-            File log    = SD.open(filename, FILE_WRITE);
-            
+            if (!detailLog.open()) {
+                return;
+            }
+
             char formattedTime[64];
             auto utc = now();
             sprintf(
@@ -300,13 +374,12 @@ public:
                 status.waterVolume,
                 ",",
                 status.waterFlow};
-            log.println(data);
-            log.flush();
-            log.close();
+            detailLog.writeLine(data);
         } else if (sampleNowActive) {
-            SD.begin(HardwarePins::SD_CARD);
-            File log    = SD.open(filename, FILE_WRITE);
-            
+            if (!detailLog.open()) {
+                return;
+            }
+
             char formattedTime[64];
             auto utc = now();
             sprintf(
@@ -337,9 +410,7 @@ public:
                 status.waterVolume,
                 ",",
                 status.waterFlow};
-            log.println(data);
-            log.flush();
-            log.close();
+            detailLog.writeLine(data);
         }
     }
 
@@ -498,7 +569,11 @@ public:
     ScheduleReturnCode scheduleNextActiveTask(bool shouldStopCurrentTask = false) {
         nowSampleButton.disableSampleButton();
         status.preventShutdown = false;
-        for (auto id : tm.getActiveSortedTaskIds()) {
+        // Invalidating a task drops only that entry from the index, so step the iterator
+        // before the body runs
+        const auto & schedule = tm.activeTaskSchedule();
+        for (auto it = schedule.begin(); it != schedule.end();) {
+            const int id    = (it++)->second;
             Task & task     = tm.tasks[id];
             time_t time_now = now();
 
@@ -538,7 +613,10 @@ public:
                 TimedAction delayTaskExecution;
                 delayTaskExecution.name     = "delayTaskExecution";
                 delayTaskExecution.interval = secsToMillis(timeUntil);
-                delayTaskExecution.callback = [this]() { taskStateController.begin(); };
+                delayTaskExecution.callback = [this]() {
+                    power.recordTaskStart();
+                    taskStateController.begin();
+                };
                 run(delayTaskExecution);  // async, will be execute later
 
                 taskStateController.configure(task);
@@ -550,8 +628,10 @@ public:
                 println("\033[32;1mExecuting task in ", timeUntil, " seconds\033[0m");
                 return ScheduleReturnCode::operating;
             } else {
-                // Wake up before not due to alarm, reschedule anyway
-                power.scheduleNextAlarm(task.schedule - 8);  // 3 < x < 10
+                // Wake up before not due to alarm, reschedule anyway. The task after this
+                // one, if any, backs up the first alarm.
+                const time_t following = it != schedule.end() ? it->first - 8 : 0;
+                power.planWake(task.schedule - 8, following);  // 3 < x < 10
                 nowSampleButton.setSampleButton();
                 return ScheduleReturnCode::scheduled;
             }
@@ -617,13 +697,85 @@ public:
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
     void update() override {
+#ifdef PERF_PROFILER
+        profiler.update();
+#else
         KPController::update();
+#endif
+        // Starting the WINC1500 blocks the loop for seconds. A request made during a task
+        // waits for the end of its pipeline so the pump and stop conditions stay serviced.
+        if (wifiRequested && !isRunningTask()) {
+            startWiFi(wifiRequested);
+            wifiRequested = nullptr;
+        }
+
         if (!status.isProgrammingMode() && !status.preventShutdown) {
             shutdown();
         }
         
     }
 
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Whether a task or a sample-now task is scheduled within seconds or running
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool isRunningTask() const {
+        return currentTaskId || sampleNowActive || status.preventShutdown;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Why WiFi should come up at boot. A task woken by the RTC has nobody to
+     *  talk to, and bringing up the WINC1500 costs seconds of boot and a lot of current.
+     *
+     *  @return const char* reason to start WiFi, nullptr to keep it powered down
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    const char * wifiStartReason() const {
+        if (status.isProgrammingMode()) {
+            return "programming mode";
+        }
+
+        if (!power.wokeByAlarm) {
+            return "manual power on";
+        }
+
+        if (config.isWithinWiFiWindow(now())) {
+            return "maintenance window";
+        }
+
+        return nullptr;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Power up the WINC1500 and start the web server. Does nothing if already
+     *  started. Must not be called while the components are updating, nor during a task:
+     *  set wifiRequested instead.
+     *
+     *  @param reason Printed with the WiFi status
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void startWiFi(const char * reason) {
+        if (wifiStarted) {
+            return;
+        }
+
+        wifiStarted = true;
+        digitalWrite(HardwarePins::WIFI_ENABLE, HIGH);
+        addComponent(server);
+        addComponent(events);
+        for (auto & asset : webUI) {
+            asset.load();
+        }
+
+        server.begin();
+
+        println();
+        println(BLUE("====================== WIFI ======================"));
+        println("Started for ", reason);
+        if (server.enabled()) {
+            server.printWiFiStatus();
+        }
+
+        println(BLUE("=================================================="));
+    }
+
     /** ────────────────────────────────────────────────────────────────────────────
      *  @brief Turn off the motor, shut off the pins and power off the system
      *
@@ -633,8 +785,12 @@ public:
         shift.writeAllRegistersLow();  // Turn off all TPIC devices
         intake.off();
 
-        tm.writeToDirectory();
+        detailLog.close();
+        tm.writeChangesToJournal();
+        tm.compactJournalIfLarger(ProgramSettings::TASK_JOURNAL_COMPACT_SIZE);
         vm.writeToDirectory();
+        BootSnapshot::save(config, vm, tm);
+        power.saveWakeLog();
         power.shutdown();
         halt(TRACE, "Shutdown. This message should not be displayed. Check power module");
     }
@@ -0,0 +1,198 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <ArduinoJson.h>
+#include <SD.h>
+
+#include <Application/Constants.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: B O O T   P R O F I L E : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Time spent in each phase of App::setup. The power module cuts power between tasks so every
+// sample pays for a full boot. The last BOOT_PROFILE_HISTORY boots are kept on the SD card in
+// a ring of fixed-size records behind a small header:
+//
+//   Header | Record (slot 0) | Record (slot 1) | ...
+//
+// Boot n goes to slot n % BOOT_PROFILE_HISTORY, so saving rewrites one record and the header.
+//
+class BootProfile {
+public:
+    enum Phase : uint8_t {
+        rtc,          // Power::setup, mostly Power::waitForConnection
+        server,       // routing, and WiFi when it is started at boot
+        sd,           // SD card init by the file loader
+        components,   // shift register, pump, sensors, ...
+        config,       // config.js or boot snapshot
+        valves,       // valve files, valve table or boot snapshot
+        tasks,        // task files and journal or boot snapshot
+        nowTask,      // nowtask.js
+        controllers,  // state controllers
+        logs,         // log headers and interrupt callbacks
+        numberOfPhases
+    };
+
+    struct Record {
+        uint32_t utc;                      // RTC time at the end of setup
+        uint32_t start;                    // millis() when setup started
+        uint16_t phases[numberOfPhases];   // ms per phase
+        uint8_t snapshot;                  // 1 if the state came from the boot snapshot
+    } __attribute__((packed));
+
+    Record current{};
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint8_t version;
+        uint8_t recordSize;
+        uint8_t capacity;
+        uint8_t reserved;
+        uint32_t count;  // Boots recorded so far
+    } __attribute__((packed));
+
+    static constexpr uint32_t magic  = 0x464F5250;  // "PROF"
+    static constexpr uint8_t version = 1;
+    static constexpr size_t capacity = ProgramSettings::BOOT_PROFILE_HISTORY;
+
+    unsigned long last = 0;  // millis() at the previous mark
+
+public:
+    static const char * phaseName(Phase phase) {
+        static const char * names[numberOfPhases] = {
+            "rtc",    "server", "sd",    "components", "config",
+            "valves", "tasks",  "nowTask", "controllers", "logs"};
+        return phase < numberOfPhases ? names[phase] : "unknown";
+    }
+
+    void begin() {
+        current       = Record{};
+        current.start = millis();
+        last          = current.start;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Close the phase: everything since the previous mark is charged to it
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void mark(Phase phase) {
+        const unsigned long time = millis();
+        current.phases[phase] += time - last;
+        last = time;
+    }
+
+    static unsigned long total(const Record & record) {
+        unsigned long sum = 0;
+        for (auto ms : record.phases) {
+            sum += ms;
+        }
+
+        return sum;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Store the current boot in the ring, replacing the oldest one if full
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void save() {
+        current.utc = now();
+
+        Header header;
+        File file = SD.open(ProgramSettings::BOOT_PROFILE_FILE, O_RDWR | O_CREAT);
+        if (!file) {
+            println(RED("Boot profile: unable to open "), ProgramSettings::BOOT_PROFILE_FILE);
+            return;
+        }
+
+        if (!readHeader(file, header)) {
+            header = Header{magic, version, sizeof(Record), capacity, 0, 0};
+        }
+
+        file.seek(sizeof(Header) + sizeof(Record) * (header.count % capacity));
+        file.write(reinterpret_cast<const uint8_t *>(&current), sizeof(Record));
+        header.count++;
+        file.seek(0);
+        file.write(reinterpret_cast<const uint8_t *>(&header), sizeof(Header));
+        file.close();
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Read the stored boots, oldest first
+     *
+     *  @param callback Called with the boot number and its record
+     *  @return size_t number of records read
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    template <typename Callback>
+    static size_t forEach(Callback && callback) {
+        File file = SD.open(ProgramSettings::BOOT_PROFILE_FILE, FILE_READ);
+        if (!file) {
+            return 0;
+        }
+
+        Header header;
+        size_t read = 0;
+        if (readHeader(file, header)) {
+            const uint32_t first = header.count > capacity ? header.count - capacity : 0;
+            for (uint32_t i = first; i < header.count; i++) {
+                Record record;
+                file.seek(sizeof(Header) + sizeof(Record) * (i % capacity));
+                if (file.read(&record, sizeof(Record)) != int(sizeof(Record))) {
+                    break;
+                }
+
+                callback(i, record);
+                read++;
+            }
+        }
+
+        file.close();
+        return read;
+    }
+
+    static void printHistory() {
+        const size_t count = forEach([](uint32_t boot, const Record & record) {
+            print("Boot ", boot, ": ", total(record), " ms", record.snapshot ? " (snapshot)" : "",
+                  ", setup at ", record.start, " ms |");
+            for (int i = 0; i < numberOfPhases; i++) {
+                print(" ", phaseName(Phase(i)), " ", record.phases[i]);
+            }
+
+            println();
+        });
+
+        if (count == 0) {
+            println("No boot profile recorded");
+        }
+    }
+
+    static constexpr size_t encodingSize() {
+        return JSON_ARRAY_SIZE(capacity)
+               + capacity * (JSON_OBJECT_SIZE(6) + JSON_OBJECT_SIZE(numberOfPhases));
+    }
+
+    static bool encodeJSON(const JsonArray & dest) {
+        bool success = true;
+        forEach([&](uint32_t boot, const Record & record) {
+            JsonObject object = dest.createNestedObject();
+            success           = success && object["boot"].set(boot)
+                      && object["utc"].set(record.utc) && object["start"].set(record.start)
+                      && object["total"].set(total(record))
+                      && object["snapshot"].set(bool(record.snapshot));
+
+            JsonObject phases = object.createNestedObject("phases");
+            for (int i = 0; i < numberOfPhases; i++) {
+                success = success && phases[phaseName(Phase(i))].set(record.phases[i]);
+            }
+        });
+
+        return success;
+    }
+
+private:
+    static bool readHeader(File & file, Header & header) {
+        file.seek(0);
+        return file.read(&header, sizeof(Header)) == int(sizeof(Header)) && header.magic == magic
+               && header.version == version && header.recordSize == sizeof(Record)
+               && header.capacity == capacity;
+    }
+};
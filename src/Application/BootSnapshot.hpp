@@ -0,0 +1,313 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <SD.h>
+
+#include <Application/Config.hpp>
+#include <Application/Constants.hpp>
+#include <Task/TaskManager.hpp>
+#include <Valve/ValveManager.hpp>
+#include <Utilities/CRC32.hpp>
+#include <Utilities/StoreGeneration.hpp>
+
+#include <vector>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: B O O T   S N A P S H O T : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Binary image of the config, the valve table and every task, written by App::shutdown after
+// the regular files are up to date. The next boot reads the fixed-size records straight into
+// memory instead of decoding config.js, the valve files and the task files with ArduinoJson.
+//
+// The JSON files stay the source of truth. The snapshot is deleted as soon as it is read so
+// that a reset or a crash before the next shutdown falls back to them. It is also ignored when
+// its CRC, version or record sizes don't match this firmware, when the valve or task files
+// were written since (see StoreGeneration), or when config.js changed. config.js is the file
+// edited by hand and is small, so it is checked by content. Delete boot.bin after editing
+// task or valve files on a computer.
+//
+// Layout: Header | ConfigRecord | ValveManager::TableRecord x valveCount | TaskRecord x taskCount
+//
+class BootSnapshot {
+public:
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t configSize;
+        uint16_t valveSize;
+        uint16_t taskSize;
+        uint16_t valveCount;
+        uint16_t taskCount;
+        uint32_t configStamp;  // CRC32 of config.js, 0 if missing
+        uint32_t generation;   // StoreGeneration when written
+        uint32_t crc;          // Of everything after the header
+    };
+
+    struct ConfigRecord {
+        signed char valveUpperBound;
+        bool packedValveTable;
+        signed char valves[ProgramSettings::MAX_VALVES];
+        char logFile[ProgramSettings::SD_FILE_NAME_LENGTH];
+        char statusFile[ProgramSettings::SD_FILE_NAME_LENGTH];
+        char taskFolder[ProgramSettings::SD_FILE_NAME_LENGTH];
+        char valveFolder[ProgramSettings::SD_FILE_NAME_LENGTH];
+        Config::WiFiWindow wifiWindows[ProgramSettings::MAX_WIFI_WINDOWS];
+        unsigned char numberOfWiFiWindows;
+    };
+
+    struct TaskRecord {
+        int id;
+        char name[TaskSettings::NAME_LENGTH];
+        char notes[TaskSettings::NOTES_LENGTH];
+        long createdAt;
+        long schedule;
+        int status;
+        int timeBetween;
+        int flushTime;
+        float flushVolume;
+        int sampleTime;
+        float sampleVolume;
+        int samplePressure;
+        int dryTime;
+        int preserveTime;
+        bool deleteOnCompletion;
+        Pipeline::Sequence pipeline;
+        Recurrence repeat;
+        int valveOffsetStart;
+        uint8_t valveCount;
+        uint8_t valves[ProgramSettings::MAX_VALVES];
+    };
+
+    static constexpr uint32_t magic   = 0x544F4F42;  // "BOOT"
+    static constexpr uint16_t version = 4;
+
+    ConfigRecord config;
+    ValveManager::TableRecord valves[ProgramSettings::MAX_VALVES];
+    size_t valveCount = 0;
+    std::vector<Task> tasks;
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Read and validate the snapshot, then delete it from the SD card
+     *
+     *  @param configFilepath Path of config.js, used to detect a stale snapshot
+     *  @return true if every record can be restored
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool load(const char * configFilepath) {
+        File file = SD.open(ProgramSettings::BOOT_SNAPSHOT_FILE, FILE_READ);
+        if (!file) {
+            return false;
+        }
+
+        Header header;
+        CRC32 crc;
+        bool valid = file.read(&header, sizeof(header)) == int(sizeof(header))
+                     && header.magic == magic && header.version == version
+                     && header.configSize == sizeof(ConfigRecord)
+                     && header.valveSize == sizeof(ValveManager::TableRecord)
+                     && header.taskSize == sizeof(TaskRecord)
+                     && header.valveCount <= ProgramSettings::MAX_VALVES;
+
+        valveCount = valid ? header.valveCount : 0;
+        valid      = valid && read(file, &config, sizeof(config), crc)
+                && read(file, valves, sizeof(valves[0]) * valveCount, crc);
+
+        tasks.reserve(valid ? header.taskCount : 0);
+        for (size_t i = 0; valid && i < header.taskCount; i++) {
+            TaskRecord record;
+            valid = read(file, &record, sizeof(record), crc);
+            if (valid) {
+                tasks.emplace_back();
+                fromRecord(tasks.back(), record);
+            }
+        }
+
+        file.close();
+        SD.remove(ProgramSettings::BOOT_SNAPSHOT_FILE);
+
+        valid = valid && crc.value() == header.crc
+                && header.generation == StoreGeneration::current()
+                && header.configStamp == stampFile(configFilepath);
+
+        if (!valid) {
+            println(RED("Boot snapshot: stale or invalid, loading JSON files"));
+            tasks.clear();
+        }
+
+        return valid;
+    }
+
+    void restore(Config & target) const {
+        target.valveUpperBound  = config.valveUpperBound;
+        target.numberOfValves   = config.valveUpperBound + 1;
+        target.packedValveTable = config.packedValveTable;
+        memcpy(target.valves, config.valves, sizeof(config.valves));
+        memcpy(target.logFile, config.logFile, sizeof(config.logFile));
+        memcpy(target.statusFile, config.statusFile, sizeof(config.statusFile));
+        memcpy(target.taskFolder, config.taskFolder, sizeof(config.taskFolder));
+        memcpy(target.valveFolder, config.valveFolder, sizeof(config.valveFolder));
+        memcpy(target.wifiWindows, config.wifiWindows, sizeof(config.wifiWindows));
+        target.numberOfWiFiWindows = config.numberOfWiFiWindows;
+        target.version++;
+    }
+
+    void restore(ValveManager & vm) const {
+        if (valveCount == vm.valves.size()) {
+            vm.restoreRecords(valves);
+        } else {
+            vm.loadValvesFromDirectory();
+        }
+    }
+
+    void restore(TaskManager & tm) {
+        tm.restoreTasks(tasks);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Write the snapshot. Call only after the JSON files were brought up to date.
+     *  The header is written last so that an interrupted write is never restored.
+     *
+     *  @return true if the whole snapshot was written
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static bool save(const Config & config, const ValveManager & vm, const TaskManager & tm) {
+        const auto start = millis();
+        File file = SD.open(ProgramSettings::BOOT_SNAPSHOT_FILE, O_RDWR | O_CREAT | O_TRUNC);
+        if (!file) {
+            println(RED("Boot snapshot: unable to open "), ProgramSettings::BOOT_SNAPSHOT_FILE);
+            return false;
+        }
+
+        Header header{};
+        header.valveCount = vm.valves.size();
+        header.taskCount  = tm.taskCollection().size();
+
+        CRC32 crc;
+        bool success = write(file, &header, sizeof(header));
+
+        ConfigRecord configRecord{};
+        configRecord.valveUpperBound  = config.valveUpperBound;
+        configRecord.packedValveTable = config.packedValveTable;
+        memcpy(configRecord.valves, config.valves, sizeof(config.valves));
+        memcpy(configRecord.logFile, config.logFile, sizeof(config.logFile));
+        memcpy(configRecord.statusFile, config.statusFile, sizeof(config.statusFile));
+        memcpy(configRecord.taskFolder, config.taskFolder, sizeof(config.taskFolder));
+        memcpy(configRecord.valveFolder, config.valveFolder, sizeof(config.valveFolder));
+        memcpy(configRecord.wifiWindows, config.wifiWindows, sizeof(config.wifiWindows));
+        configRecord.numberOfWiFiWindows = config.numberOfWiFiWindows;
+        success = success && write(file, &configRecord, sizeof(configRecord), crc);
+
+        for (const auto & valve : vm.valves) {
+            const auto record = ValveManager::toRecord(valve);
+            success           = success && write(file, &record, sizeof(record), crc);
+        }
+
+        for (const auto & kv : tm.taskCollection()) {
+            TaskRecord record{};
+            toRecord(record, kv.second);
+            success = success && write(file, &record, sizeof(record), crc);
+        }
+
+        header.magic       = magic;
+        header.version     = version;
+        header.configSize  = sizeof(ConfigRecord);
+        header.valveSize   = sizeof(ValveManager::TableRecord);
+        header.taskSize    = sizeof(TaskRecord);
+        header.crc         = crc.value();
+        header.configStamp = stampFile(config.configFilepath);
+        header.generation  = StoreGeneration::current();
+        success = success && file.seek(0) && write(file, &header, sizeof(header));
+        file.close();
+
+        if (!success) {
+            println(RED("Boot snapshot: write failed"));
+            SD.remove(ProgramSettings::BOOT_SNAPSHOT_FILE);
+            return false;
+        }
+
+        StoreGeneration::mark();
+        println(GREEN("Boot snapshot"), " written in ", millis() - start, " ms");
+        return true;
+    }
+
+private:
+    static bool read(File & file, void * data, size_t size, CRC32 & crc) {
+        if (file.read(data, size) != int(size)) {
+            return false;
+        }
+
+        crc.update(data, size);
+        return true;
+    }
+
+    static bool write(File & file, const void * data, size_t size) {
+        return file.write(static_cast<const uint8_t *>(data), size) == size;
+    }
+
+    static bool write(File & file, const void * data, size_t size, CRC32 & crc) {
+        crc.update(data, size);
+        return write(file, data, size);
+    }
+
+    // CRC32 of the path and content of a file, 0 if missing
+    static uint32_t stampFile(const char * filepath) {
+        File file = SD.open(filepath, FILE_READ);
+        if (!file) {
+            return 0;
+        }
+
+        CRC32 crc;
+        crc.update(filepath, strlen(filepath));
+        uint8_t buffer[128];
+        for (int n; (n = file.read(buffer, sizeof(buffer))) > 0;) {
+            crc.update(buffer, n);
+        }
+
+        file.close();
+        return crc.value();
+    }
+
+    static void toRecord(TaskRecord & record, const Task & task) {
+        record.id = task.id;
+        memcpy(record.name, task.name, sizeof(record.name));
+        memcpy(record.notes, task.notes, sizeof(record.notes));
+        record.createdAt          = task.createdAt;
+        record.schedule           = task.schedule;
+        record.status             = task.status;
+        record.timeBetween        = task.timeBetween;
+        record.flushTime          = task.flushTime;
+        record.flushVolume        = task.flushVolume;
+        record.sampleTime         = task.sampleTime;
+        record.sampleVolume       = task.sampleVolume;
+        record.samplePressure     = task.samplePressure;
+        record.dryTime            = task.dryTime;
+        record.preserveTime       = task.preserveTime;
+        record.deleteOnCompletion = task.deleteOnCompletion;
+        record.pipeline           = task.pipeline;
+        record.repeat             = task.repeat;
+        record.valveOffsetStart   = task.valveOffsetStart;
+        record.valveCount = std::min(task.valves.size(), size_t(ProgramSettings::MAX_VALVES));
+        std::copy_n(task.valves.begin(), record.valveCount, record.valves);
+    }
+
+    static void fromRecord(Task & task, const TaskRecord & record) {
+        task.id = record.id;
+        memcpy(task.name, record.name, sizeof(task.name));
+        memcpy(task.notes, record.notes, sizeof(task.notes));
+        task.createdAt          = record.createdAt;
+        task.schedule           = record.schedule;
+        task.status             = record.status;
+        task.timeBetween        = record.timeBetween;
+        task.flushTime          = record.flushTime;
+        task.flushVolume        = record.flushVolume;
+        task.sampleTime         = record.sampleTime;
+        task.sampleVolume       = record.sampleVolume;
+        task.samplePressure     = record.samplePressure;
+        task.dryTime            = record.dryTime;
+        task.preserveTime       = record.preserveTime;
+        task.deleteOnCompletion = record.deleteOnCompletion;
+        task.pipeline           = record.pipeline;
+        task.repeat             = record.repeat;
+        task.valveOffsetStart   = record.valveOffsetStart;
+        task.valves.assign(record.valves, record.valves + record.valveCount);
+    }
+};
@@ -15,7 +15,15 @@
 // ────────────────────────────────────────────────────────────────────────────────
 class Config : public JsonDecodable, public JsonEncodable, public Printable {
 public:
+    // Daily period (RTC time) during which WiFi is started even on an alarm wake. A window
+    // where `from` is later than `to` spans midnight.
+    struct WiFiWindow {
+        short from;  // minutes past midnight, inclusive
+        short to;    // minutes past midnight, exclusive
+    };
+
     bool shutdownOverride       = true;
+    bool packedValveTable       = false;
     const char * configFilepath = nullptr;
     signed char valveUpperBound = 0;
     signed char numberOfValves  = 0;
@@ -26,6 +34,12 @@ public:
     char taskFolder[ProgramSettings::SD_FILE_NAME_LENGTH]  = {0};
     char valveFolder[ProgramSettings::SD_FILE_NAME_LENGTH] = {0};
 
+    WiFiWindow wifiWindows[ProgramSettings::MAX_WIFI_WINDOWS] = {};
+    unsigned char numberOfWiFiWindows                         = 0;
+
+    // Incremented each time the config is loaded, exposed as the ETag of /api/config
+    unsigned long version = 0;
+
 public:
     // Config()			   = delete;
     // Config(const Config &) = delete;
@@ -37,8 +51,20 @@ public:
         return "Config";
     }
 
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Room for every key of the file with MAX_VALVES free valves and
+     *  MAX_WIFI_WINDOWS windows. A document that does not fit halts the load instead of
+     *  silently losing windows.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static constexpr size_t jsonSize() {
+        using namespace ProgramSettings;
+        return JSON_OBJECT_SIZE(8) + JSON_ARRAY_SIZE(MAX_VALVES)
+               + JSON_ARRAY_SIZE(MAX_WIFI_WINDOWS) + MAX_WIFI_WINDOWS * JSON_OBJECT_SIZE(2)
+               + CONFIG_JSON_STRING_SIZE;
+    }
+
     static constexpr size_t decodingSize() {
-        return ProgramSettings::CONFIG_JSON_BUFFER_SIZE;
+        return jsonSize();
     }
 
     void decodeJSON(const JsonVariant & source) override {
@@ -69,6 +95,45 @@ public:
         strncpy(statusFile, source[FILE_STATUS], SD_FILE_NAME_LENGTH);
         strncpy(taskFolder, source[FOLDER_TASK], SD_FILE_NAME_LENGTH);
         strncpy(valveFolder, source[FOLDER_VALVE], SD_FILE_NAME_LENGTH);
+        packedValveTable = source[PACKED_VALVE_TABLE] | false;
+        version++;
+
+        numberOfWiFiWindows = 0;
+        for (JsonObjectConst window : source[WIFI_WINDOWS].as<JsonArrayConst>()) {
+            if (numberOfWiFiWindows == MAX_WIFI_WINDOWS) {
+                println(RED("Config: ignoring WiFi windows past "), MAX_WIFI_WINDOWS);
+                break;
+            }
+
+            const int from = decodeClockTime(window[WIFI_WINDOW_FROM] | "");
+            const int to   = decodeClockTime(window[WIFI_WINDOW_TO] | "");
+            if (from < 0 || to < 0) {
+                println(RED("Config: WiFi window needs \"from\" and \"to\" as HH:MM"));
+                continue;
+            }
+
+            wifiWindows[numberOfWiFiWindows++] = WiFiWindow{short(from), short(to)};
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Check if the time of day falls inside one of the WiFi maintenance windows
+     *
+     *  @param time RTC time in seconds
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool isWithinWiFiWindow(time_t time) const {
+        const int minutes = (time % 86400) / 60;
+        for (int i = 0; i < numberOfWiFiWindows; i++) {
+            const auto & window = wifiWindows[i];
+            const bool within   = window.from <= window.to
+                                    ? minutes >= window.from && minutes < window.to
+                                    : minutes >= window.from || minutes < window.to;
+            if (within) {
+                return true;
+            }
+        }
+
+        return false;
     }
 
 #pragma region JSONENCODABLE
@@ -77,7 +142,7 @@ public:
     }
 
     static constexpr size_t encodingSize() {
-        return ProgramSettings::CONFIG_JSON_BUFFER_SIZE;
+        return jsonSize();
     }
 
     bool encodeJSON(const JsonVariant & dest) const override {
@@ -86,9 +151,24 @@ public:
         JsonArray array_array = dest.createNestedArray(VALVES_FREE);
         copyArray(valves, array_array);
 
+        JsonArray windows = dest.createNestedArray(WIFI_WINDOWS);
+        for (int i = 0; i < numberOfWiFiWindows; i++) {
+            char from[12];
+            char to[12];
+            snprintf(from, sizeof(from), "%02d:%02d", wifiWindows[i].from / 60,
+                     wifiWindows[i].from % 60);
+            snprintf(to, sizeof(to), "%02d:%02d", wifiWindows[i].to / 60, wifiWindows[i].to % 60);
+
+            JsonObject window = windows.createNestedObject();
+            if (!window[WIFI_WINDOW_FROM].set(from) || !window[WIFI_WINDOW_TO].set(to)) {
+                return false;
+            }
+        }
+
         return dest[VALVE_UPPER_BOUND].set(valveUpperBound) && dest[FILE_LOG].set(logFile)
                && dest[FILE_STATUS].set(statusFile) && dest[FOLDER_TASK].set(taskFolder)
-               && dest[FOLDER_VALVE].set(valveFolder);
+               && dest[FOLDER_VALVE].set(valveFolder)
+               && dest[PACKED_VALVE_TABLE].set(packedValveTable);
     }
 #pragma endregion
 #pragma region PRINTABLE
@@ -100,4 +180,16 @@ public:
         return serializeJsonPretty(doc, Serial);
     }
 #pragma endregion
+
+private:
+    // "HH:MM" to minutes past midnight, -1 if malformed
+    static int decodeClockTime(const char * text) {
+        int hours   = 0;
+        int minutes = 0;
+        if (sscanf(text, "%d:%d", &hours, &minutes) != 2) {
+            return -1;
+        }
+
+        return constrain(hours, 0, 23) * 60 + constrain(minutes, 0, 59);
+    }
 };
\ No newline at end of file
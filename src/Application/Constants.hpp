@@ -42,12 +42,13 @@ namespace HardwarePins {
     __k_auto SD_CARD           = 10;
     __k_auto SHFT_REG_CLOCK    = 11;
     __k_auto SHFT_REG_DATA     = 12;
+    __k_auto WIFI_ENABLE       = 2;  // WINC1500 chip enable, low keeps the radio powered down
 };  // namespace HardwarePins
 
 namespace ProgramSettings {
     __k_auto CONFIG_FILE_PATH          = "config.js";
     __k_auto SD_FILE_NAME_LENGTH       = 13;
-    __k_auto CONFIG_JSON_BUFFER_SIZE   = 800;
+    __k_auto CONFIG_JSON_STRING_SIZE   = 256;  // bytes of keys and values copied from config.js
     __k_auto STATUS_JSON_BUFFER_SIZE   = 800;
     __k_auto TASK_JSON_BUFFER_SIZE     = 1000;
     __k_auto TASKREF_JSON_BUFFER_SIZE  = 50;
@@ -55,6 +56,33 @@ namespace ProgramSettings {
     __k_auto VALVE_JSON_BUFFER_SIZE    = 500;
     __k_auto VALVEREF_JSON_BUFFER_SIZE = 50;
     __k_auto VALVE_GROUP_LENGTH        = 25;
+    __k_auto TASK_JOURNAL_FILE         = "journal.log";
+    __k_auto TASK_JOURNAL_COMPACT_SIZE = 16384;  // bytes, compacted at shutdown past this
+    __k_auto BOOT_SNAPSHOT_FILE        = "boot.bin";
+    __k_auto STORE_GENERATION_FILE     = "gen.bin";
+    __k_auto BOOT_PROFILE_FILE         = "bootprof.bin";
+    __k_auto BOOT_PROFILE_HISTORY      = 8;
+    __k_auto VALVE_TABLE_FILE          = "table.bin";
+    __k_auto DETAIL_LOG_FILE           = "detail.csv";
+    __k_auto DETAIL_LOG_BUFFER_SIZE    = 1024;
+    __k_auto PROFILED_COMPONENTS       = 16;
+    __k_auto BARO_IDLE_RESOLUTION      = 4096;  // MS5803 oversampling outside of Sample
+    __k_auto BARO_SAMPLE_RESOLUTION    = 256;   // and during Sample, where the loop is busiest
+    __k_auto OUTPUT_REFRESH_INTERVAL   = 10000; // ms between rewrites of held outputs
+    __k_auto MAX_PIPELINE_STAGES       = 12;
+    __k_auto WAKE_WATCHDOG_DELAY       = 60;    // s after a planned wake before alarm 2 fires
+    __k_auto WAKE_HISTORY              = 8;
+    __k_auto WAKE_LOG_FILE             = "wakes.bin";
+    __k_auto MAX_WIFI_WINDOWS          = 4;
+    __k_auto WIFI_WINDOW_CHECK_PERIOD  = 60000; // ms between maintenance window checks
+    __k_auto HTTP_CHUNK_SIZE           = 256;   // bytes per chunk of a streamed response
+    __k_auto MAX_EVENT_CLIENTS         = 2;
+    __k_auto EVENT_STREAM_INTERVAL     = 250;   // ms, shortest time between two events
+    __k_auto EVENT_STREAM_HEARTBEAT    = 15000; // ms of silence before a keep-alive comment
+    __k_auto EVENT_STREAM_BUFFER_SIZE  = 640;   // bytes, one whole event plus headers
+    __k_auto STATIC_ASSET_BUFFER_SIZE  = 2048;  // bytes per SD read of the web UI bundle
+    // Fresh for an hour, then revalidated with its ETag
+    __k_auto STATIC_ASSET_CACHE_CONTROL = "public, max-age=3600, immutable";
 };  // namespace ProgramSettings
 
 namespace TaskSettings {
@@ -71,12 +99,16 @@ namespace TaskSettings {
 // These are used to retrieve values from ArduinoJson's JSON Object
 
 namespace ConfigKeys {
-    __k_auto VALVES_FREE       = "freeValves";
-    __k_auto VALVE_UPPER_BOUND = "valveUpperBound";
-    __k_auto FILE_LOG          = "logFile";
-    __k_auto FILE_STATUS       = "statusFile";
-    __k_auto FOLDER_TASK       = "taskFolder";
-    __k_auto FOLDER_VALVE      = "valveFolder";
+    __k_auto VALVES_FREE        = "freeValves";
+    __k_auto VALVE_UPPER_BOUND  = "valveUpperBound";
+    __k_auto FILE_LOG           = "logFile";
+    __k_auto FILE_STATUS        = "statusFile";
+    __k_auto FOLDER_TASK        = "taskFolder";
+    __k_auto FOLDER_VALVE       = "valveFolder";
+    __k_auto PACKED_VALVE_TABLE = "packedValveTable";
+    __k_auto WIFI_WINDOWS       = "wifiWindows";
+    __k_auto WIFI_WINDOW_FROM   = "from";
+    __k_auto WIFI_WINDOW_TO     = "to";
 }  // namespace ConfigKeys
 
 namespace TaskKeys {
@@ -98,8 +130,31 @@ namespace TaskKeys {
     __k_auto DRY_TIME        = "dryTime";
     __k_auto PRESERVE_TIME   = "preserveTime";
     __k_auto CURR_VALVE   = "currentValve";
+    __k_auto PIPELINE        = "pipeline";
+    __k_auto PIPELINE_STAGE  = "stage";
+    __k_auto PIPELINE_TIME   = "time";
+    __k_auto REPEAT          = "repeat";
+    __k_auto REPEAT_RULE     = "rule";
+    __k_auto REPEAT_EVERY    = "every";
+    __k_auto REPEAT_AT       = "at";
+    __k_auto REPEAT_COUNT    = "count";
+    __k_auto REPEAT_DONE     = "done";
 }  // namespace TaskKeys
 
+namespace TaskQueryKeys {
+    __k_auto STATUS = "status";
+    __k_auto OFFSET = "offset";
+    __k_auto LIMIT  = "limit";
+    __k_auto FIELDS = "fields";
+}  // namespace TaskQueryKeys
+
+namespace JournalKeys {
+    __k_auto OP     = "op";
+    __k_auto ID     = "id";
+    __k_auto STATUS = "status";
+    __k_auto TASK   = "task";
+}  // namespace JournalKeys
+
 namespace ValveKeys {
     __k_auto ID     = "id";
     __k_auto STATUS = "status";
@@ -0,0 +1,152 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <ArduinoJson.h>
+#include <WiFi101.h>
+
+#include <Application/Constants.hpp>
+#include <Application/Status.hpp>
+#include <Utilities/Log.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: E V E N T   S T R E A M : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Server-sent events (text/event-stream) for live views. Each client keeps one connection
+// open and gets the whole status when it connects, then a "status" event holding only the
+// fields whose group changed:
+//
+//   event: status
+//   data: {"pressure":3.2,"temperature":14.1}
+//
+// Changes reported by the Status observer callbacks are coalesced and sent at most once per
+// EVENT_STREAM_INTERVAL, however often the sensors update. A comment line is sent when the
+// stream has been quiet for EVENT_STREAM_HEARTBEAT so that closed connections are noticed.
+//
+// WiFi101 sends one packet per write call, so every event is formatted in a stack buffer and
+// handed to each client with a single write.
+//
+class EventStream : public KPComponent {
+private:
+    Status & status;
+    WiFiClient clients[ProgramSettings::MAX_EVENT_CLIENTS];
+    bool connected[ProgramSettings::MAX_EVENT_CLIENTS]{};
+
+    unsigned long lastEvent = 0;
+    unsigned long lastWrite = 0;
+
+public:
+    unsigned long events = 0;  // Events sent, all clients counted once
+
+    EventStream(const char * name, Status & status) : KPComponent(name), status(status) {}
+
+    size_t numberOfClients() const {
+        return std::count(connected, connected + ProgramSettings::MAX_EVENT_CLIENTS, true);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Take over the connection of a request: send the headers and the whole
+     *  status, then keep the client for the next events
+     *
+     *  @return true if there was a free slot for the client
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool add(WiFiClient & client) {
+        for (int i = 0; i < ProgramSettings::MAX_EVENT_CLIENTS; i++) {
+            if (connected[i]) {
+                continue;
+            }
+
+            clients[i]   = client;
+            connected[i] = true;
+            send(clients[i], format(Status::allChanged,
+                                    "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\n"
+                                    "Cache-Control: no-cache\r\nConnection: keep-alive\r\n\r\n"));
+            return true;
+        }
+
+        return false;
+    }
+
+    void update() override {
+        const unsigned long time = millis();
+        if (time - lastEvent < ProgramSettings::EVENT_STREAM_INTERVAL) {
+            return;
+        }
+
+        lastEvent = time;
+        dropClosedClients();
+
+        // Always taken so that changes made while nobody listens don't pile up
+        const uint8_t changes = status.takeChanges();
+        if (numberOfClients() == 0) {
+            return;
+        }
+
+        if (changes) {
+            const Event event = format(changes);
+            for (int i = 0; i < ProgramSettings::MAX_EVENT_CLIENTS; i++) {
+                if (connected[i]) {
+                    send(clients[i], event);
+                }
+            }
+
+            events++;
+        } else if (time - lastWrite >= ProgramSettings::EVENT_STREAM_HEARTBEAT) {
+            for (int i = 0; i < ProgramSettings::MAX_EVENT_CLIENTS; i++) {
+                if (connected[i]) {
+                    clients[i].print(":\n\n");
+                }
+            }
+
+            lastWrite = time;
+        }
+    }
+
+private:
+    struct Event {
+        char text[ProgramSettings::EVENT_STREAM_BUFFER_SIZE];
+        size_t length = 0;
+    };
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Format a "status" event holding the fields of the changed groups
+     *
+     *  @param changes Status::Change flags
+     *  @param preamble Sent before the event in the same write (ex: response headers)
+     *  @return Event empty if it doesn't fit in EVENT_STREAM_BUFFER_SIZE
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    Event format(uint8_t changes, const char * preamble = "") const {
+        StaticJsonDocument<Status::encodingSize()> doc;
+        status.encodeChanges(changes, doc.to<JsonObject>());
+
+        Event event;
+        const int length = snprintf(event.text, sizeof(event.text), "%sevent: status\ndata: ",
+                                    preamble);
+        // Room for the data, the blank line and the null terminator of serializeJson
+        if (length < 0 || length + measureJson(doc) + 3 > sizeof(event.text)) {
+            LOG_ERROR(api, "Event exceeds EVENT_STREAM_BUFFER_SIZE");
+            return event;
+        }
+
+        event.length = length;
+        event.length += serializeJson(doc, event.text + event.length,
+                                      sizeof(event.text) - event.length);
+        event.text[event.length++] = '\n';
+        event.text[event.length++] = '\n';
+        return event;
+    }
+
+    void send(WiFiClient & client, const Event & event) {
+        client.write(reinterpret_cast<const uint8_t *>(event.text), event.length);
+        lastWrite = millis();
+    }
+
+    void dropClosedClients() {
+        for (int i = 0; i < ProgramSettings::MAX_EVENT_CLIENTS; i++) {
+            if (connected[i] && !clients[i].connected()) {
+                clients[i].stop();
+                connected[i] = false;
+            }
+        }
+    }
+};
@@ -41,6 +41,22 @@ public:
     const char * currentStateName = nullptr;
     const char * currentTaskName  = nullptr;
 
+    // Groups of fields changed by the observer callbacks, for the event stream
+    enum Change : uint8_t {
+        valvesChanged   = 1 << 0,  // valves
+        stateChanged    = 1 << 1,  // currentState, currentTask
+        pressureChanged = 1 << 2,  // pressure, temperature
+        baroChanged     = 1 << 3,  // barometric
+        depthChanged    = 1 << 4,  // waterDepth
+        flowChanged     = 1 << 5,  // waterFlow, waterVolume, sampleVolume
+        allChanged      = 0x3F
+    };
+
+private:
+    uint8_t pendingChanges = 0;  // Change groups not yet taken by the event stream
+
+public:
+
     // Status() = default;
     // Status(const Status &) = delete;
     // Status & operator=(const Status &) = delete;
@@ -78,6 +94,7 @@ private:
         }
 
         valves[valve.id] = valve.status;
+        pendingChanges |= valvesChanged;
     }
 
     void valveArrayDidUpdate(const std::vector<Valve> & valves) override {
@@ -89,6 +106,7 @@ private:
 
     void stateDidBegin(const KPState * current) override {
         currentStateName = current->getName();
+        pendingChanges |= stateChanged;
     }
 
     //
@@ -101,20 +119,24 @@ private:
         waterFlow    = values.lpm;
         waterVolume  = values.volume;
         sampleVolume = values.volume;
+        pendingChanges |= flowChanged;
     }
 
     void pressureSensorDidUpdate(PressureSensor::SensorData & values) override {
         pressure    = std::get<0>(values);
         temperature = std::get<1>(values);
         maxPressure = max(pressure, maxPressure);
+        pendingChanges |= pressureChanged;
     }
 
     void baro1DidUpdate(BaroSensor::SensorData & values) override {
         barometric = std::get<0>(values);
+        pendingChanges |= baroChanged;
     }
 
     void baro2DidUpdate(BaroSensor::SensorData & values) override {
         waterDepth = std::get<0>(values);
+        pendingChanges |= depthChanged;
     }
 
     bool isBatteryLow() const {
@@ -187,6 +209,54 @@ public:
         // clang-format on
     }
 
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Groups changed since the last call, then start over
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    uint8_t takeChanges() {
+        const uint8_t taken = pendingChanges;
+        pendingChanges      = 0;
+        return taken;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Encode only the fields of the given groups. Same keys as encodeJSON.
+     *
+     *  @param groups Bitwise or of Change values
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool encodeChanges(uint8_t groups, const JsonVariant & dest) const {
+        using namespace StatusKeys;
+        bool success = true;
+        if (groups & valvesChanged) {
+            success = copyArray(valves.data(), valves.size(), dest.createNestedArray(VALVES))
+                      && success;
+        }
+
+        if (groups & stateChanged) {
+            success = dest[CURRENT_STATE].set(currentStateName)
+                      && dest[CURRENT_TASK].set(currentTaskName) && success;
+        }
+
+        if (groups & pressureChanged) {
+            success = dest[SENSOR_PRESSURE].set(pressure) && dest[SENSOR_TEMP].set(temperature)
+                      && success;
+        }
+
+        if (groups & baroChanged) {
+            success = dest[SENSOR_BARO].set(barometric) && success;
+        }
+
+        if (groups & depthChanged) {
+            success = dest[SENSOR_DEPTH].set(waterDepth) && success;
+        }
+
+        if (groups & flowChanged) {
+            success = dest[SENSOR_FLOW].set(waterFlow) && dest[SENSOR_VOLUME].set(waterVolume)
+                      && dest[SAMPLE_VOLUME].set(sampleVolume) && success;
+        }
+
+        return success;
+    }
+
 #pragma endregion JSONENCODABLE
 #pragma region PRINTABLE
     size_t printTo(Print & printer) const override {
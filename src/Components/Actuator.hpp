@@ -0,0 +1,144 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <Application/Constants.hpp>
+#include <Components/Intake.hpp>
+#include <Components/Pump.hpp>
+#include <Components/ShiftRegister.hpp>
+
+enum class IntakePosition : uint8_t { unchanged, on, off };
+enum class PumpMode : uint8_t { off, normal, reverse };
+
+constexpr uint8_t device(int tpicDevice) {
+    return 1 << tpicDevice;
+}
+
+/** ────────────────────────────────────────────────────────────────────────────
+ *  @brief Outputs a state wants, ex: flush valve open with the intake on and the pump
+ *  running forward. The Actuator brings the hardware there in three steps:
+ *
+ *  1. Pump off, every valve closed and the intake driven to its position
+ *  2. After valveDelay: intake released, the devices and the task valve opened
+ *  3. After pumpDelay: pump on
+ *
+ *  ──────────────────────────────────────────────────────────────────────────── */
+struct OutputSet {
+    uint8_t devices          = 0;      // TPICDevices to open, ex: device(TPICDevices::AIR_VALVE)
+    bool currentValve        = false;  // open the valve of the current task
+    IntakePosition intake    = IntakePosition::unchanged;
+    PumpMode pump            = PumpMode::normal;
+    unsigned long valveDelay = 5;  // secs, time for the ball intake to turn
+    unsigned long pumpDelay  = 6;  // secs, pump starts once the valves are open
+};
+
+/** ────────────────────────────────────────────────────────────────────────────
+ *  @brief Owns the timing of the valves, intake and pump for the shared states. Hardware
+ *  is only touched when a step is due. While holding a set, the shift registers are
+ *  rewritten every refreshInterval in case a latch got corrupted.
+ *
+ *  ──────────────────────────────────────────────────────────────────────────── */
+class Actuator : public KPComponent {
+public:
+    enum class Step : uint8_t { released, valves, pump, holding };
+
+    unsigned long refreshInterval = ProgramSettings::OUTPUT_REFRESH_INTERVAL;  // ms, 0 disables
+    unsigned long refreshes       = 0;
+
+private:
+    ShiftRegister & shift;
+    Pump & pump;
+    Intake & intake;
+
+    OutputSet outputs;
+    int valvePin              = -1;
+    Step step                 = Step::released;
+    unsigned long appliedTime = 0;
+    unsigned long writeTime   = 0;
+
+public:
+    Actuator(const char * name, ShiftRegister & shift, Pump & pump, Intake & intake)
+        : KPComponent(name), shift(shift), pump(pump), intake(intake) {}
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Start moving to a new set. Replaces whatever set was in progress.
+     *
+     *  @param set Desired outputs
+     *  @param currentValvePin Shift register pin of the task valve, used if
+     *  set.currentValve
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void apply(const OutputSet & set, int currentValvePin) {
+        outputs     = set;
+        valvePin    = set.currentValve ? currentValvePin : -1;
+        appliedTime = millis();
+        step        = Step::valves;
+
+        pump.off();
+        shift.setAllRegistersLow();
+        switch (set.intake) {
+        case IntakePosition::on:
+            intake.on();
+            break;
+        case IntakePosition::off:
+            intake.off();
+            break;
+        default:
+            shift.write();
+        }
+
+        // Zero delays take effect right away
+        update();
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Stop driving the outputs. Pending steps are dropped and the hardware is
+     *  left as is for whoever takes over (ex: Stop, OffshootPreload, serial commands).
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void release() {
+        step = Step::released;
+    }
+
+    Step currentStep() const {
+        return step;
+    }
+
+    void update() override {
+        if (step == Step::released) {
+            return;
+        }
+
+        const unsigned long elapsed = millis() - appliedTime;
+        if (step == Step::valves && elapsed >= secsToMillis(outputs.valveDelay)) {
+            writeValves(false);
+            step = Step::pump;
+        }
+
+        if (step == Step::pump && elapsed >= secsToMillis(outputs.pumpDelay)) {
+            if (outputs.pump != PumpMode::off) {
+                pump.on(outputs.pump == PumpMode::normal ? Direction::normal : Direction::reverse);
+            }
+
+            step = Step::holding;
+        }
+
+        if (step != Step::valves && refreshInterval
+            && (unsigned long) (millis() - writeTime) >= refreshInterval) {
+            writeValves(true);
+            refreshes++;
+        }
+    }
+
+private:
+    void writeValves(bool force) {
+        shift.setAllRegistersLow();
+        for (int pin = 0; pin < ShiftRegister::capacityPerRegister; pin++) {
+            shift.setPin(pin, outputs.devices & device(pin));
+        }
+
+        if (valvePin >= 0) {
+            shift.setPin(valvePin, HIGH);
+        }
+
+        shift.write(force);
+        writeTime = millis();
+    }
+};
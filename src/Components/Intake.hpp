@@ -1,3 +1,4 @@
+#pragma once
 #include <KPFoundation.hpp>
 #include <Application/Constants.hpp>
 #include <Components/ShiftRegister.hpp>
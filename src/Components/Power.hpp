@@ -25,6 +25,7 @@
 #include <LowPower.h>
 #include <Wire.h>
 #include <SPI.h>
+#include <SD.h>
 #include <functional>
 
 #include <Application/Constants.hpp>
@@ -46,9 +47,45 @@ extern void rtc_isr();
 
 class Power : public KPComponent {
 public:
+    // One entry per alarm wake, kept for `query wake`
+    struct Wake {
+        time_t planned = 0;   // RTC time the alarm was set for, 0 if unknown
+        time_t woke    = 0;   // RTC time the wake was serviced
+        uint8_t alarm  = 0;   // Alarm that fired, 1 (next task) or 2 (following / watchdog)
+        long latency   = -1;  // Milliseconds from wake to task start, -1 if none started
+    };
+
     DS3232RTC rtc;
     std::function<void()> interruptCallback;
 
+private:
+    // The power module cuts power between tasks: the plan, the history and the missed alarm
+    // count are saved to WAKE_LOG_FILE by saveWakeLog and restored by loadWakeLog.
+    struct WakeLogHeader {
+        uint32_t magic;
+        uint8_t version;
+        uint8_t wakeSize;
+        uint8_t capacity;
+        uint8_t reserved;
+    } __attribute__((packed));
+
+    static constexpr uint32_t wakeLogMagic  = 0x454B4157;  // "WAKE"
+    static constexpr uint8_t wakeLogVersion = 1;
+
+    time_t alarmTimes[2]{0, 0};  // Planned RTC time of alarm 1 and 2, 0 when disarmed
+    Wake wakes[ProgramSettings::WAKE_HISTORY];
+    uint32_t wakeCount       = 0;
+    unsigned long wakeMillis = 0;
+
+    // Alarm that powered up the board, recorded by loadWakeLog once the plan is known
+    uint8_t bootAlarm        = 0;
+    time_t bootTime          = 0;
+    unsigned long bootMillis = 0;
+
+public:
+    uint32_t missedAlarms = 0;
+    bool wokeByAlarm      = false;  // Powered up by an RTC alarm rather than by hand
+
     Power(const char * name) : KPComponent(name), rtc(false) {}
 
     void onInterrupt(std::function<void()> callbcak) {
@@ -60,6 +97,14 @@ public:
         waitForConnection();
         rtc.begin();
 
+        // The board may have been powered up by an alarm: note which one before clearing it
+        const bool primary = rtc.alarm(ALARM_1);
+        const bool backup  = rtc.alarm(ALARM_2);
+        wokeByAlarm = primary || backup;
+        bootAlarm   = primary ? ALARM_1 : backup ? ALARM_2 : 0;
+        bootTime    = rtc.get();
+        bootMillis  = millis();
+
         // Reset RTC to a known state, clearing alarms, clear interrupts
         resetAlarms();
         rtc.squareWave(SQWAVE_NONE);
@@ -94,7 +139,10 @@ public:
 
         // Check if the interrupt is comming from RTC
         // This is important in noisy environment
-        if (rtc.alarm(1) || rtc.alarm(2)) {
+        const bool primary = rtc.alarm(ALARM_1);
+        const bool backup  = rtc.alarm(ALARM_2);
+        if (primary || backup) {
+            recordWake(primary ? ALARM_1 : ALARM_2, rtc.get(), millis());
             disarmAlarms();
             noInterrupts();
             interruptCallback();
@@ -135,12 +183,66 @@ public:
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  Set alarms registers to a known value and clear any prev alarms
-     *
+     *  Restore what saveWakeLog kept across the power cut, then record the wake that
+     *  powered up the board against the plan. A plan whose alarm 1 passed while the board
+     *  stayed off counts as missed. Call once the SD card is ready.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void loadWakeLog() {
+        File file = SD.open(ProgramSettings::WAKE_LOG_FILE, FILE_READ);
+        WakeLogHeader header;
+        const bool valid
+            = file && read(file, header) && header.magic == wakeLogMagic
+              && header.version == wakeLogVersion && header.wakeSize == sizeof(Wake)
+              && header.capacity == ProgramSettings::WAKE_HISTORY && read(file, alarmTimes)
+              && read(file, missedAlarms) && read(file, wakeCount) && read(file, wakes);
+        file.close();
+
+        if (!valid) {
+            alarmTimes[0] = alarmTimes[1] = 0;
+            missedAlarms = wakeCount = 0;
+        }
+
+        if (bootAlarm) {
+            recordWake(bootAlarm, bootTime, bootMillis);
+        } else if (alarmTimes[0] && alarmTimes[0] < bootTime) {
+            missedAlarms++;
+            println(RED("Alarm 1 missed, powered up by hand"));
+        }
+
+        // setupRTC reset both alarms
+        alarmTimes[0] = alarmTimes[1] = 0;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  Save the wake plan and history for the next power up. Call right before
+     *  shutdown.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void saveWakeLog() {
+        File file = SD.open(ProgramSettings::WAKE_LOG_FILE, O_RDWR | O_CREAT | O_TRUNC);
+        if (!file) {
+            println(RED("Power: unable to open "), ProgramSettings::WAKE_LOG_FILE);
+            return;
+        }
+
+        const WakeLogHeader header{
+            wakeLogMagic, wakeLogVersion, sizeof(Wake), ProgramSettings::WAKE_HISTORY, 0};
+        write(file, header);
+        write(file, alarmTimes);
+        write(file, missedAlarms);
+        write(file, wakeCount);
+        write(file, wakes);
+        file.close();
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  Set alarms registers to a known value and clear any prev alarms. The DS3231 sets
+     *  the alarm flags even with their interrupt disabled, and setupRTC reads them to tell
+     *  an alarm wake from a manual power on. Date 0 never occurs so the reset alarms can
+     *  not raise a flag while the board is off.
      *  ──────────────────────────────────────────────────────────────────────────── */
     void resetAlarms() {
-        rtc.setAlarm(ALM1_MATCH_DATE, 0, 0, 0, 1);
-        rtc.setAlarm(ALM2_MATCH_DATE, 0, 0, 0, 1);
+        rtc.setAlarm(ALM1_MATCH_DATE, 0, 0, 0, 0);
+        rtc.setAlarm(ALM2_MATCH_DATE, 0, 0, 0, 0);
         disarmAlarms();
     }
 
@@ -153,6 +255,8 @@ public:
         rtc.alarm(ALARM_2);
         rtc.alarmInterrupt(ALARM_1, false);
         rtc.alarmInterrupt(ALARM_2, false);
+        alarmTimes[0] = 0;
+        alarmTimes[1] = 0;
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
@@ -192,13 +296,77 @@ public:
      *  @param usingInterrupt If true, the rtc fires interrupt at HardwarePins::RTC_INTERRUPT
      *  ──────────────────────────────────────────────────────────────────────────── */
     void setTimeout(unsigned long seconds, bool usingInterrupt) {
-        TimeElements future;
-        breakTime(rtc.get() + seconds, future);
         disarmAlarms();
-        rtc.setAlarm(ALM1_MATCH_MINUTES, future.Second, future.Minute, future.Hour, 0);
-        if (usingInterrupt) {
-            attachInterrupt(digitalPinToInterrupt(HardwarePins::RTC_INTERRUPT), rtc_isr, FALLING);
-            rtc.alarmInterrupt(1, true);
+        setAlarm(ALARM_1, rtc.get() + seconds, usingInterrupt);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  Program both RTC alarms in one go. Alarm 1 wakes the board for the next event.
+     *  Alarm 2 wakes it for the event after that or, if there is none or it is further
+     *  away, shortly after alarm 1 as a watchdog. If alarm 1 is missed, the board still
+     *  wakes up and plans again instead of sleeping until someone power cycles it.
+     *
+     *  @param next RTC time of the next wake
+     *  @param following RTC time of the wake after that, 0 if none
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void planWake(time_t next, time_t following = 0) {
+        disarmAlarms();
+        setAlarm(ALARM_1, next, true);
+
+        // Alarm 2 matches whole minutes. Rounded down it never fires after the following
+        // wake; if that puts it before alarm 1, both wakes are within a minute and the
+        // following one is planned after the next wake instead.
+        time_t backup = next + ProgramSettings::WAKE_WATCHDOG_DELAY;
+        if (following > next) {
+            backup = std::min(following, backup);
+        }
+
+        backup = backup / SECS_PER_MIN * SECS_PER_MIN;
+        if (backup > next) {
+            setAlarm(ALARM_2, backup, true);
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  Record the wake to start latency of the last wake. Call when the task that the
+     *  wake was planned for starts.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void recordTaskStart() {
+        if (wakeCount == 0) {
+            return;
+        }
+
+        Wake & wake = wakes[(wakeCount - 1) % ProgramSettings::WAKE_HISTORY];
+        if (wake.latency < 0) {
+            wake.latency = millis() - wakeMillis;
+        }
+    }
+
+    void printWakePlan() {
+        for (int i = 0; i < 2; i++) {
+            print("Alarm ", i + 1, ": ");
+            if (alarmTimes[i]) {
+                printTime(alarmTimes[i]);
+            } else {
+                print("disarmed");
+            }
+
+            println();
+        }
+
+        println("Missed alarms: ", missedAlarms);
+
+        const size_t count = std::min<size_t>(wakeCount, ProgramSettings::WAKE_HISTORY);
+        for (size_t i = wakeCount - count; i < wakeCount; i++) {
+            const Wake & wake = wakes[i % ProgramSettings::WAKE_HISTORY];
+            print("Wake ", i, " alarm ", wake.alarm, " at ");
+            printTime(wake.woke);
+            print(" late ", wake.planned ? long(wake.woke - wake.planned) : 0, " s, start ");
+            if (wake.latency < 0) {
+                println("none");
+            } else {
+                println(wake.latency, " ms");
+            }
         }
     }
 
@@ -224,7 +392,7 @@ public:
         }
 
         println("Alarm triggering in: ", utc - timestamp, " seconds");
-        setTimeout(utc - timestamp, true);
+        planWake(utc);
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
@@ -293,4 +461,52 @@ public:
         constexpr time_t FUDGE = 10;
         return t + FUDGE;
     }
+
+private:
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  Set one alarm to fire at an absolute time. Alarm 1 matches to the second, alarm 2
+     *  only to the minute so the seconds of `utc` must be 0. Both match on the day of
+     *  month so they fire once instead of every hour.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void setAlarm(uint8_t alarm, time_t utc, bool usingInterrupt) {
+        TimeElements future;
+        if (alarm == ALARM_1) {
+            breakTime(utc, future);
+            rtc.setAlarm(ALM1_MATCH_DATE, future.Second, future.Minute, future.Hour, future.Day);
+        } else {
+            breakTime(utc, future);
+            rtc.setAlarm(ALM2_MATCH_DATE, future.Minute, future.Hour, future.Day);
+        }
+
+        alarmTimes[alarm - 1] = utc;
+        if (usingInterrupt) {
+            attachInterrupt(digitalPinToInterrupt(HardwarePins::RTC_INTERRUPT), rtc_isr, FALLING);
+            rtc.alarmInterrupt(alarm, true);
+        }
+    }
+
+    void recordWake(uint8_t alarm, time_t woke, unsigned long atMillis) {
+        Wake & wake = wakes[wakeCount++ % ProgramSettings::WAKE_HISTORY];
+        wake.planned = alarmTimes[alarm - 1];
+        wake.woke    = woke;
+        wake.alarm   = alarm;
+        wake.latency = -1;
+        wakeMillis   = atMillis;
+
+        // Alarm 2 is always planned after alarm 1, firing alone means alarm 1 never did
+        if (alarm == ALARM_2 && alarmTimes[0] && alarmTimes[0] < wake.woke) {
+            missedAlarms++;
+            println(RED("Alarm 1 missed, woken up by alarm 2"));
+        }
+    }
+
+    template <typename T>
+    static bool read(File & file, T & value) {
+        return file.read(&value, sizeof(T)) == int(sizeof(T));
+    }
+
+    template <typename T>
+    static void write(File & file, const T & value) {
+        file.write(reinterpret_cast<const uint8_t *>(&value), sizeof(T));
+    }
 };
\ No newline at end of file
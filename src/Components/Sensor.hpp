@@ -16,8 +16,12 @@ auto call(Function f, Tuple t) {
     return call(f, t, std::make_index_sequence<size>{});
 }
 
-template <typename _SensorData, typename... Types>
-class Sensor {
+/**
+ * Scheduling state and error reporting shared by every sensor, independent of the data type.
+ * Each instance keeps its own begin flag and deadline so that two sensors of the same type
+ * (ex: baro1 and baro2) are initialized and rate limited separately.
+ */
+class SensorBase {
 public:
     struct ErrorCode {
         enum Code { success = 0, notReady, notEnabled, invalidChecksum } _code;
@@ -34,29 +38,46 @@ private:
     ErrorCode errorCode          = ErrorCode::success;
     unsigned long updateInterval = 0;
 
-public:
-    using SensorData = const _SensorData;
+protected:
+    bool didBegin             = false;
+    unsigned long lastUpdate  = 0;  // start of the current update interval
+    unsigned long lastAttempt = 0;  // last call to read()
+    unsigned long retryDelay  = 0;
 
     /**
-     * When this property is set, calling the update function will forward the sensor response to
-     * the callback upon successful reading.
+     * Called from read() when the reading is not complete yet (ex: a conversion is still
+     * running) to come back sooner than the update interval. Only applies to the next update.
      *
+     * @param ms Time until the next update
      */
-    std::function<void(SensorData)> onReceived;
+    void retryIn(unsigned long ms) {
+        retryDelay = ms;
+    }
 
-    /**
-     * Subclass should override this method for setting up the sensor for reading/writing
-     */
-private:
-    virtual void begin() = 0;
+    unsigned long nextInterval() const {
+        return retryDelay ? retryDelay : updateInterval;
+    }
 
-public:
     /**
-     * Sublass should override this method to return SensorData
+     * Intervals start on a fixed grid so that the rate of readings does not drift with loop
+     * latency or retries. A sensor more than an interval behind restarts from now.
      *
-     * @return SensorData Object instance of type SensorData provided in the template parameter
+     * @param now millis() after read()
      */
-    virtual SensorData read() = 0;
+    void didAttempt(unsigned long now) {
+        lastAttempt = now;
+        if (!retryDelay) {
+            const bool onTime = (now - lastUpdate) - updateInterval < updateInterval;
+            lastUpdate        = onTime ? lastUpdate + updateInterval : now;
+        }
+    }
+
+    unsigned long elapsed(unsigned long now) const {
+        return now - (retryDelay ? lastAttempt : lastUpdate);
+    }
+
+public:
+    virtual ~SensorBase() = default;
 
     /**
      * Set the Error Code
@@ -89,6 +110,54 @@ public:
         }
     }
 
+    /**
+     * True if calling update() now would either begin the sensor or read from it
+     *
+     * @param now millis()
+     */
+    bool isDue(unsigned long now) const {
+        return enabled && (!didBegin || elapsed(now) >= nextInterval());
+    }
+
+    /**
+     * How far past its deadline the sensor is, in ms. A sensor that has not begun yet counts as
+     * the most overdue so that it gets initialized first.
+     *
+     * @param now millis()
+     */
+    unsigned long overdue(unsigned long now) const {
+        return didBegin ? elapsed(now) - nextInterval() : ULONG_MAX;
+    }
+
+    virtual ErrorCode update() = 0;
+};
+
+template <typename _SensorData, typename... Types>
+class Sensor : public SensorBase {
+public:
+    using SensorData = const _SensorData;
+
+    /**
+     * When this property is set, calling the update function will forward the sensor response to
+     * the callback upon successful reading.
+     *
+     */
+    std::function<void(SensorData)> onReceived;
+
+    /**
+     * Subclass should override this method for setting up the sensor for reading/writing
+     */
+private:
+    virtual void begin() = 0;
+
+public:
+    /**
+     * Sublass should override this method to return SensorData
+     *
+     * @return SensorData Object instance of type SensorData provided in the template parameter
+     */
+    virtual SensorData read() = 0;
+
     /**
      * Calling this method will trigger a call to read() only if time between call is more than the
      * configured interval setting. Results from read() will then be forwarded to onReceived
@@ -96,30 +165,27 @@ public:
      *
      * @return ErrorCode
      */
-    virtual ErrorCode update() final {
+    ErrorCode update() final {
         if (!enabled) {
             return ErrorCode::notEnabled;
         }
 
-        static bool didBegin = false;
+        // The first read happens one interval after begin()
         if (!didBegin) {
             didBegin = true;
             begin();
+            lastUpdate = millis();
         }
 
-        // Lazy evaluation: last_update will never be initialized if the sensor is not enabled;
-        // last_update is initialized to millis() here in the first call, and then set below
-        // see link for another examples of static vars in functions: 
-        // https://www.tutorialspoint.com/what-is-the-lifetime-of-a-static-variable-in-a-cplusplus-function
-        static long last_update = millis();
-        if ((millis() - last_update) < updateInterval) {
+        if (!isDue(millis())) {
             return ErrorCode::notReady;
         }
 
         setErrorCode(ErrorCode::success);
+        retryDelay           = 0;
         const auto response  = read();
         const auto errorCode = getErrorCode();
-        last_update          = millis();
+        didAttempt(millis());
 
         if (errorCode == ErrorCode::success && onReceived) {
             onReceived(response);
@@ -101,10 +101,39 @@ public:
 
     }
 
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Oversampling of both barometric sensors. States trade resolution for
+     *  shorter conversions while the loop has more to do.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void setBaroResolution(uint16_t resolution) {
+        baro1.setResolution(resolution);
+        baro2.setResolution(resolution);
+    }
+
+    // Sensors on the I2C bus. Each read blocks the loop until the transfer completes.
+    SensorBase * const busSensors[3] = {&pressure, &baro1, &baro2};
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief The flow sensor only reads counters kept by its ISR, so it is checked every
+     *  loop. Of the I2C sensors that are due, only the one furthest past its deadline is
+     *  read. This bounds the time spent on the bus in any one loop to a single sensor and
+     *  spreads the reads of sensors sharing the same rate over consecutive loops.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
     void update() override {
         flow.update();
-        pressure.update();
-        baro1.update();
-        baro2.update();
+
+        const unsigned long now = millis();
+        SensorBase * next       = nullptr;
+        for (auto sensor : busSensors) {
+            if (sensor->isDue(now) && (!next || sensor->overdue(now) > next->overdue(now))) {
+                next = sensor;
+            }
+        }
+
+        if (next) {
+            next->update();
+        }
     }
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <Components/Sensor.hpp>
+#include <Application/Constants.hpp>
 #include <MS5803_02.h>
 
 class BaroSensor : public Sensor<float, float> {
@@ -12,8 +13,28 @@ private:
     }
 
 public:
-    BaroSensor(byte address) : sensor(address, 512) {}
+    BaroSensor(byte address) : sensor(address, ProgramSettings::BARO_IDLE_RESOLUTION) {}
+
+    /**
+     * Oversampling for the conversions that follow (256 to 4096). Higher is less noisy but
+     * each of the two conversions takes longer (0.6 to 9 ms).
+     */
+    void setResolution(uint16_t resolution) {
+        sensor.setResolution(resolution);
+    }
+
+    /**
+     * Steps the conversion instead of waiting for it. A reading takes three updates: start
+     * the pressure conversion, read it and start the temperature conversion, then read that
+     * and compute. The updates in between return notReady and are scheduled for when the
+     * conversion is done, so the loop never sits in delay() for this sensor.
+     */
     SensorData read() override {
+        if (!sensor.poll()) {
+            setErrorCode(ErrorCode::notReady);
+            retryIn((sensor.conversionMicros() + 999) / 1000);
+        }
+
         return {sensor.pressure(), sensor.temperature()};
     }
-};
\ No newline at end of file
+};
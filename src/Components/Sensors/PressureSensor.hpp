@@ -4,7 +4,13 @@
 
 class PressureSensor : public Sensor<float, float> {
 private:
+    // The SSC refreshes its output every few hundred micros, so stale data clears quickly.
+    // Past the budget the reading is skipped until the next interval.
+    static constexpr unsigned long staleRetryDelay = 1;
+    static constexpr unsigned int staleRetryBudget = 5;
+
     SSC sensor;
+    unsigned int staleRetries = 0;
 
     void begin() override {
         setUpdateFreq(3);
@@ -16,10 +22,31 @@ private:
     };
 
 public:
+    unsigned long staleReads = 0;  // stale responses since boot
+
     PressureSensor(int addr) : sensor(addr) {}
 
+    /**
+     * One I2C transaction per call. Stale data is notReady and retried shortly after, up to
+     * staleRetryBudget times per reading. Any other error skips the reading.
+     */
     SensorData read() override {
-        sensor.update();
+        const uint8_t error = sensor.poll();
+        if (error == SSC::StaleDataError) {
+            staleReads++;
+            if (staleRetries++ < staleRetryBudget) {
+                retryIn(staleRetryDelay);
+            }
+        }
+
+        if (error != SSC::NoError) {
+            setErrorCode(ErrorCode::notReady);
+        }
+
+        if (!retryDelay) {
+            staleRetries = 0;
+        }
+
         return {sensor.pressure(), sensor.temperature()};
     }
 };
@@ -1,13 +1,23 @@
 #include <Components/Sensors/TurbineFlowSensor.hpp>
 
-volatile unsigned long lastFlowTick;
-volatile unsigned long flowIntervalMicros;
-volatile bool flowUpdated;
+volatile FlowPulses flowPulses;
 
 void flowTick() {
-	//This is the time interval since the last flowTick
-	flowIntervalMicros = micros() - lastFlowTick;
-	lastFlowTick	   = micros();
-	//make sure to read data
-	flowUpdated		   = true;
-}
\ No newline at end of file
+	const unsigned long now      = micros();
+	const unsigned long interval = now - flowPulses.last;
+
+	// Contact bounce: faster than the sensor can spin
+	if (interval < FlowPulses::minIntervalMicros) {
+		return;
+	}
+
+	flowPulses.last = now;
+	flowPulses.times[flowPulses.head] = now;
+	flowPulses.head = (flowPulses.head + 1) % FlowPulses::capacity;
+
+	// The first pulse after the flow stopped only marks the start of a new run
+	if (interval < flowPulses.timeoutMicros) {
+		flowPulses.count++;
+		flowPulses.activeMicros += interval;
+	}
+}
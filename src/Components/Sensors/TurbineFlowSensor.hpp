@@ -1,9 +1,26 @@
 #pragma once
 #include <Components/Sensor.hpp>
+#include <Utilities/Log.hpp>
 
-extern volatile unsigned long lastFlowTick;
-extern volatile unsigned long flowIntervalMicros;
-extern volatile bool flowUpdated;
+#include <algorithm>
+
+/**
+ * Shared between flowTick (ISR) and TurbineFlowSensor. The ISR only counts pulses, the time
+ * they cover and keeps the timestamps of the last few. Everything else happens in read().
+ */
+struct FlowPulses {
+    static constexpr size_t capacity                 = 8;
+    static constexpr unsigned long minIntervalMicros = 500;  // 2 kHz, twice the sensor max
+
+    unsigned long times[capacity]{};  // timestamps of the most recent pulses (ring)
+    size_t head                 = 0;
+    unsigned long last          = 0;       // timestamp of the most recent pulse
+    unsigned long count         = 0;       // pulses that followed another within the timeout
+    unsigned long activeMicros  = 0;       // sum of the intervals of those pulses
+    unsigned long timeoutMicros = 500000;  // longer gap than this means the flow stopped
+};
+
+extern volatile FlowPulses flowPulses;
 
 void flowTick();
 
@@ -18,18 +35,60 @@ struct TurbineFlowSensorData {
 
 class TurbineFlowSensor : public Sensor<TurbineFlowSensorData> {
 private:
+    //The spec sheet says that the output frequency is between 36.6 to 917 Hz
+    //flow that the sensor can record is between 0.1LPM and 2.5LPM
+    static constexpr double minHz  = 37;
+    static constexpr double maxHz  = 917;
+    static constexpr double minLpm = 0.110;
+    static constexpr double maxLpm = 2.476;
+
+    // lpm = offset + slope * hz
+    static constexpr double slope  = (maxLpm - minLpm) / (maxHz - minHz);
+    static constexpr double offset = minLpm - slope * minHz;
+
+    // ISR counters as of the last integration
+    unsigned long countedPulses = 0;
+    unsigned long countedMicros = 0;
+
     void begin() override {
-        lastFlowTick = micros();
         pinMode(A3, INPUT);
         //sensor is updated once a second
-        setUpdateFreq(1000);
+        setUpdateFreq(1);
+    }
+
+    /**
+     * Copy the ISR state with interrupts off. The fields are multi-byte and the ISR could fire
+     * halfway through reading them.
+     */
+    static void snapshot(unsigned long & count, unsigned long & activeMicros,
+                         unsigned long & last, unsigned long * times) {
+        noInterrupts();
+        count        = flowPulses.count;
+        activeMicros = flowPulses.activeMicros;
+        last         = flowPulses.last;
+        for (size_t i = 0; i < FlowPulses::capacity; i++) {
+            times[i] = flowPulses.times[(flowPulses.head + i) % FlowPulses::capacity];
+        }
+        interrupts();
     }
 
 public:
     double volume = 0;
     double lpm    = 0;
 
+    /**
+     * Report zero flow if no pulse arrived for this long. The sensor pulses at 37 Hz at its
+     * lowest flow, so anything well above 27ms works.
+     */
+    void setNoPulseTimeout(unsigned long ms) {
+        noInterrupts();
+        flowPulses.timeoutMicros = ms * 1000;
+        interrupts();
+    }
+
     void resetVolume() {
+        unsigned long last, times[FlowPulses::capacity];
+        snapshot(countedPulses, countedMicros, last, times);
         volume = 0;
     }
 
@@ -39,26 +98,60 @@ public:
 
     void stopMeasurement() {
         detachInterrupt(digitalPinToInterrupt(A3));
+        lpm = 0;
+    }
+
+    /**
+     * Add the pulses counted since the last call to the volume and return it. Cheap enough to
+     * call every loop, which is what volume-terminated samples do.
+     *
+     * Each pulse covers 1 / hz seconds at (offset + slope * hz) lpm. Summed over N pulses
+     * spanning T seconds, the volume is (offset * T + slope * N) / 60 liters no matter how the
+     * rate changed in between, so there is no need to look at individual intervals.
+     */
+    double measuredVolume() {
+        unsigned long count, activeMicros, last, times[FlowPulses::capacity];
+        snapshot(count, activeMicros, last, times);
+
+        const unsigned long pulses = count - countedPulses;
+        const double seconds       = (activeMicros - countedMicros) / 1000000.0;
+        countedPulses              = count;
+        countedMicros              = activeMicros;
+
+        volume += (offset * seconds + slope * pulses) / 60;
+        return volume;
     }
 
     SensorData read() override {
-        if (flowUpdated) {
-            flowUpdated = false;
-            //micro is 1e-6, so we divide the micros in a second with the flow interval
-            //to get the frequency
-            auto hz = 1000000.0 / double(flowIntervalMicros);
-            //The spec sheet says that the output frequency is between 36.6 to 917 Hz
-            //So if hz is less than 37/36.6, then the flow is zero. Otherwise, interporlate
-            //between the frequency into the flow rate.
-            //flow that the sensor can record is between 0.1LPM and 2.5LPM
-            lpm     = hz < 37 ? 0 : interpolate(hz, 37, 917, 0.110, 2.476);
-            //LPM * change in minute gives volume in liters
-            volume += lpm * (flowIntervalMicros / 60000000.0);
-            println("Volume: ", volume, ", LPM: ", lpm);
+        unsigned long count, activeMicros, last, times[FlowPulses::capacity];
+        snapshot(count, activeMicros, last, times);
+        const bool pulsed = count != countedPulses;
+        measuredVolume();
+
+        // Rate from the median interval of the recent pulses, which ignores the odd missed or
+        // extra pulse. Intervals longer than the timeout span a stop and are left out.
+        unsigned long intervals[FlowPulses::capacity - 1];
+        size_t n = 0;
+        for (size_t i = 1; i < FlowPulses::capacity; i++) {
+            const unsigned long interval = times[i] - times[i - 1];
+            if (times[i - 1] && interval < flowPulses.timeoutMicros) {
+                intervals[n++] = interval;
+            }
+        }
+
+        if (n == 0 || micros() - last >= flowPulses.timeoutMicros) {
+            lpm = 0;
         } else {
-            setErrorCode(ErrorCode::notReady);
+            std::nth_element(intervals, intervals + n / 2, intervals + n);
+            const double hz = 1000000.0 / intervals[n / 2];
+            //if hz is less than 37, then the flow is zero
+            lpm = hz < minHz ? 0 : interpolate(hz, minHz, maxHz, minLpm, maxLpm);
+        }
+
+        if (pulsed) {
+            LOG_DEBUG(sensors, "Volume: ", volume, ", LPM: ", lpm);
         }
 
         return {volume, lpm};
     }
-};
\ No newline at end of file
+};
@@ -23,30 +23,56 @@
 #include <KPFoundation.hpp>
 #include <SPI.h>
 
-class ShiftRegister : public KPComponent {
+/**
+ * Daisy chained shift registers. Pins are set in a local copy with set* and go out to the
+ * chain with write*. The last latched pattern is kept so that writing the same pattern again
+ * is skipped: most states rewrite the whole chain every second with the same valves.
+ *
+ * On SAMD the bits are clocked out through the port registers rather than shiftOut() and
+ * digitalWrite(), which look up the pin on every edge. The SERCOM SPI peripheral cannot be
+ * used on this board: no SERCOM can put its clock on SHFT_REG_CLOCK (pin 11, PA16).
+ *
+ * @tparam count Number of registers in the chain
+ */
+template <size_t count>
+class BasicShiftRegister : public KPComponent {
 public:
-    const int capacityPerRegister = 8;
-    const int registersCount;
+    static constexpr int capacityPerRegister = 8;
+    static constexpr int registersCount      = count;
     const int dataPin;
     const int clockPin;
     const int latchPin;
 
-    int8_t * registers;
+    uint8_t registers[count]{};
     BitOrder bitOrder = MSBFIRST;
 
+    struct Stats {
+        unsigned long writes     = 0;  // patterns latched to the outputs
+        unsigned long skipped    = 0;  // writes skipped because the outputs already matched
+        unsigned long lastMicros = 0;  // duration of the last write
+        unsigned long maxMicros  = 0;
+    } stats;
+
+private:
+    uint8_t latched[count]{};
+    bool latchedValid = false;
+
+#ifdef ARDUINO_ARCH_SAMD
+    PortGroup * dataPort  = nullptr;
+    PortGroup * clockPort = nullptr;
+    uint32_t dataMask     = 0;
+    uint32_t clockMask    = 0;
+#endif
+
 public:
-    ShiftRegister(const char * name, int registerCount, int data, int clock, int latch)
-        : KPComponent(name),
-          registersCount(registerCount),
-          dataPin(data),
-          clockPin(clock),
-          latchPin(latch) {
-        registers = new int8_t[registersCount]();
+    BasicShiftRegister(const char * name, int data, int clock, int latch)
+        : KPComponent(name), dataPin(data), clockPin(clock), latchPin(latch) {
         setRegisterPins(data, clock, latch);
     }
 
     void setup() override {
-        writeAllRegistersLow();
+        setAllRegistersLow();
+        write(true);
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
@@ -61,6 +87,13 @@ public:
         pinMode(dataPin, OUTPUT);
         pinMode(clockPin, OUTPUT);
         pinMode(latchPin, OUTPUT);
+
+#ifdef ARDUINO_ARCH_SAMD
+        dataPort  = &PORT->Group[g_APinDescription[dataPin].ulPort];
+        clockPort = &PORT->Group[g_APinDescription[clockPin].ulPort];
+        dataMask  = 1ul << g_APinDescription[dataPin].ulPin;
+        clockMask = 1ul << g_APinDescription[clockPin].ulPin;
+#endif
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
@@ -89,15 +122,11 @@ public:
     }
 
     void setAllRegistersLow() {
-        for (int i = 0; i < registersCount; i++) {
-            registers[i] = 0;
-        }
+        memset(registers, 0, sizeof(registers));
     }
 
     void setAllRegistersHigh() {
-        for (int i = 0; i < registersCount; i++) {
-            registers[i] = 0xFF;
-        }
+        memset(registers, 0xFF, sizeof(registers));
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
@@ -134,15 +163,29 @@ public:
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  Shiftout each byte in the register array in reverse order
+     *  Shiftout each byte in the register array in reverse order, unless the outputs
+     *  already show this pattern.
      *
+     *  @param force Write even if nothing changed
      *  ──────────────────────────────────────────────────────────────────────────── */
-    void write() {
+    void write(bool force = false) {
+        if (!force && latchedValid && memcmp(registers, latched, sizeof(registers)) == 0) {
+            stats.skipped++;
+            return;
+        }
+
+        const unsigned long start = micros();
         digitalWrite(latchPin, LOW);
         for (int i = registersCount - 1; i >= 0; i--) {
-            shiftOut(dataPin, clockPin, bitOrder, registers[i]);
+            shiftByte(registers[i]);
         }
         digitalWrite(latchPin, HIGH);
+
+        memcpy(latched, registers, sizeof(registers));
+        latchedValid     = true;
+        stats.lastMicros = micros() - start;
+        stats.maxMicros  = std::max(stats.maxMicros, stats.lastMicros);
+        stats.writes++;
     }
 
     void writePin(int index, bool signal) {
@@ -180,4 +223,32 @@ public:
         setPin(pinNumber, HIGH);
         write();
     }
-};
\ No newline at end of file
+
+    void printStats() const {
+        println(name, ": ", stats.writes, " writes, ", stats.skipped, " skipped, last ",
+                stats.lastMicros, " us, max ", stats.maxMicros, " us");
+    }
+
+private:
+    void shiftByte(uint8_t value) {
+#ifdef ARDUINO_ARCH_SAMD
+        // Same waveform as shiftOut(): data is set while the clock is low, sampled on the rise
+        for (int i = 0; i < 8; i++) {
+            const uint8_t bit = bitOrder == MSBFIRST ? 7 - i : i;
+            if (value & (1 << bit)) {
+                dataPort->OUTSET.reg = dataMask;
+            } else {
+                dataPort->OUTCLR.reg = dataMask;
+            }
+
+            clockPort->OUTSET.reg = clockMask;
+            clockPort->OUTCLR.reg = clockMask;
+        }
+#else
+        shiftOut(dataPin, clockPin, bitOrder, value);
+#endif
+    }
+};
+
+// The board chains four TPIC6B595: three for the valves plus one for the TPICDevices
+using ShiftRegister = BasicShiftRegister<4>;
@@ -0,0 +1,29 @@
+#include <StateControllers/PipelineStateController.hpp>
+#include <Application/App.hpp>
+
+void PipelineStateController::setup() {
+    // Stage states move on to whatever comes next in the pipeline
+    const auto next = [this](int code) {
+        switch (code) {
+        case 0:
+            return advance();
+        default:
+            halt(TRACE, "Unhandled state transition: ", code);
+        }
+    };
+
+    registerState(SharedStates::Flush(), FLUSH, next);
+    registerState(SharedStates::OffshootClean(5), OFFSHOOT_CLEAN, next);
+    registerState(SharedStates::Sample(), SAMPLE, [this, next](int code) {
+        auto & app = *static_cast<App *>(controller);
+        app.sensors.flow.stopMeasurement();
+        app.logAfterSample();
+        next(code);
+    });
+    registerState(SharedStates::Dry(), DRY, next);
+    registerState(SharedStates::Preserve(), PRESERVE, next);
+    registerState(SharedStates::AirFlush(), AIR_FLUSH, next);
+    registerState(SharedStates::AlcoholPurge(), ALCOHOL_PURGE, next);
+    registerState(SharedStates::Stop(), STOP, IDLE);
+    registerState(SharedStates::Idle(), IDLE);
+};
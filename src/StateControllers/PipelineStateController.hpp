@@ -0,0 +1,258 @@
+#pragma once
+#include <ArduinoJson.h>
+#include <Components/StateController.hpp>
+#include <States/Shared.hpp>
+
+namespace Pipeline {
+    STATE(IDLE);
+    STATE(FLUSH);
+    STATE(OFFSHOOT_CLEAN);
+    STATE(SAMPLE);
+    STATE(DRY);
+    STATE(PRESERVE);
+    STATE(AIR_FLUSH);
+    STATE(ALCOHOL_PURGE);
+    STATE(STOP);
+
+    //
+    // ─── STAGE LIBRARY ──────────────────────────────────────────────────────────
+    //
+    // Every stage a task can list in its pipeline. `key` is the name used in the task JSON,
+    // `state` the state the controller runs for it and `time` its duration when neither the
+    // pipeline nor the task sets one. To add a stage, add it here, to the enum and register its
+    // state in Controller::setup().
+    //
+    enum class Stage : uint8_t {
+        flush,
+        offshootClean,
+        sample,
+        dry,
+        preserve,
+        airFlush,
+        alcoholPurge,
+        count
+    };
+
+    struct StageInfo {
+        Stage stage;
+        const char * key;
+        const char * state;
+        unsigned long time;  // secs
+    };
+
+    constexpr StageInfo library[] = {
+        {Stage::flush, "flush", FLUSH, 10},
+        {Stage::offshootClean, "offshootClean", OFFSHOOT_CLEAN, 5},
+        {Stage::sample, "sample", SAMPLE, 150},
+        {Stage::dry, "dry", DRY, 10},
+        {Stage::preserve, "preserve", PRESERVE, 0},
+        {Stage::airFlush, "airFlush", AIR_FLUSH, 15},
+        {Stage::alcoholPurge, "alcoholPurge", ALCOHOL_PURGE, 10},
+    };
+
+    constexpr bool isLibraryInOrder(size_t i = 0) {
+        return i == sizeof(library) / sizeof(library[0])
+               || (library[i].stage == Stage(i) && isLibraryInOrder(i + 1));
+    }
+
+    static_assert(sizeof(library) / sizeof(library[0]) == size_t(Stage::count)
+                      && isLibraryInOrder(),
+                  "Pipeline::library must list every Stage in enum order");
+
+    constexpr const StageInfo & info(Stage stage) {
+        return library[size_t(stage)];
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Look up a stage by its JSON key
+     *
+     *  @return true if found
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    inline bool stageFromKey(const char * key, Stage & stage) {
+        for (const auto & entry : library) {
+            if (key && strcmp(entry.key, key) == 0) {
+                stage = entry.stage;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    struct Step {
+        Stage stage;
+        long time = -1;  // secs, -1 uses the time the task sets for this kind of stage
+    };
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Ordered list of stages a task runs, ex:
+     *  [{"stage": "flush", "time": 20}, {"stage": "sample"}, {"stage": "dry"}]
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    struct Sequence {
+        static constexpr size_t capacity = ProgramSettings::MAX_PIPELINE_STAGES;
+
+        Step steps[capacity];
+        size_t size = 0;
+
+        bool add(Stage stage, long time = -1) {
+            if (size == capacity) {
+                return false;
+            }
+
+            steps[size++] = {stage, time};
+            return true;
+        }
+
+        bool empty() const {
+            return size == 0;
+        }
+
+        /** ────────────────────────────────────────────────────────────────────────────
+         *  @brief The sequence every task ran before pipelines were configurable. Used
+         *  when a task does not have one.
+         *
+         *  ──────────────────────────────────────────────────────────────────────────── */
+        static Sequence standard() {
+            Sequence sequence;
+            sequence.add(Stage::flush);
+            sequence.add(Stage::offshootClean, 5);
+            sequence.add(Stage::flush);
+            sequence.add(Stage::sample);
+            sequence.add(Stage::offshootClean, 10);
+            sequence.add(Stage::dry);
+            sequence.add(Stage::preserve);
+            sequence.add(Stage::airFlush);
+            return sequence;
+        }
+
+        // Includes the stage names copied while decoding
+        static constexpr size_t jsonSize() {
+            return JSON_ARRAY_SIZE(capacity) + capacity * (JSON_OBJECT_SIZE(2) + 16);
+        }
+
+        /** ────────────────────────────────────────────────────────────────────────────
+         *  @brief Unknown stages and stages past the capacity are skipped with a warning
+         *
+         *  ──────────────────────────────────────────────────────────────────────────── */
+        void decodeJSON(const JsonArray & source) {
+            size = 0;
+            for (JsonObject object : source) {
+                Stage stage;
+                const char * key = object[TaskKeys::PIPELINE_STAGE];
+                const long time  = object[TaskKeys::PIPELINE_TIME] | -1L;
+                if (!stageFromKey(key, stage) || !add(stage, time)) {
+                    println(RED("Skipping pipeline stage: "), key ? key : "null");
+                }
+            }
+        }
+
+        bool encodeJSON(const JsonArray & dest) const {
+            for (size_t i = 0; i < size; i++) {
+                JsonObject object = dest.createNestedObject();
+                if (!object[TaskKeys::PIPELINE_STAGE].set(info(steps[i].stage).key)) {
+                    return false;
+                }
+
+                if (steps[i].time >= 0 && !object[TaskKeys::PIPELINE_TIME].set(steps[i].time)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    };
+
+    struct Config {
+        decltype(SharedStates::Flush::time) flushTime;
+        decltype(SharedStates::Sample::time) sampleTime;
+        decltype(SharedStates::Sample::pressure) samplePressure;
+        decltype(SharedStates::Sample::volume) sampleVolume;
+        decltype(SharedStates::Dry::time) dryTime;
+        decltype(SharedStates::Preserve::time) preserveTime;
+        Sequence pipeline;
+    };
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Runs the pipeline of a task, then STOP and IDLE. Each stage state is
+     *  registered once; the controller sets its parameters right before entering it, so
+     *  the same stage can appear several times with different times.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    class Controller : public StateControllerWithConfig<Config> {
+    private:
+        size_t position = 0;
+
+    public:
+        Controller(const char * name) : StateControllerWithConfig(name) {}
+
+        void setup() override;
+
+        void begin() override {
+            position = 0;
+            enterStep();
+        }
+
+        void stop() override {
+            transitionTo(STOP);
+        }
+
+        void idle() override {
+            transitionTo(IDLE);
+        }
+
+        bool isStop() {
+            return getCurrentState()->getName() == STOP;
+        }
+
+        // Index of the running stage in the pipeline
+        size_t currentPosition() const {
+            return position;
+        }
+
+    private:
+        void advance() {
+            position++;
+            enterStep();
+        }
+
+        /** ────────────────────────────────────────────────────────────────────────────
+         *  @brief Configure the stage at `position` and transition to it, or to STOP
+         *  past the last one
+         *
+         *  ──────────────────────────────────────────────────────────────────────────── */
+        void enterStep() {
+            if (position >= config.pipeline.size) {
+                return transitionTo(STOP);
+            }
+
+            const Step & step = config.pipeline.steps[position];
+            const char * name = info(step.stage).state;
+            auto & state      = getState<SharedStates::OutputState>(name);
+            switch (step.stage) {
+            case Stage::flush:
+                state.time = step.time >= 0 ? step.time : config.flushTime;
+                break;
+            case Stage::sample: {
+                auto & sample   = getState<SharedStates::Sample>(name);
+                sample.time     = step.time >= 0 ? step.time : config.sampleTime;
+                sample.pressure = config.samplePressure;
+                sample.volume   = config.sampleVolume;
+                break;
+            }
+            case Stage::dry:
+                state.time = step.time >= 0 ? step.time : config.dryTime;
+                break;
+            case Stage::preserve:
+                state.time = step.time >= 0 ? step.time : config.preserveTime;
+                break;
+            default:
+                state.time = step.time >= 0 ? step.time : info(step.stage).time;
+            }
+
+            transitionTo(name);
+        }
+    };
+}  // namespace Pipeline
+
+using PipelineStateController = Pipeline::Controller;
@@ -2,66 +2,49 @@
 #include <Application/App.hpp>
 
 namespace SharedStates {
+    void OutputState::applyOutputs(KPStateMachine & sm) {
+        auto & app = *static_cast<App *>(sm.controller);
+        app.actuator.apply(outputs, app.currentValveIdToPin());
+    }
+
+    void OutputState::enter(KPStateMachine & sm) {
+        applyOutputs(sm);
+        setTimeCondition(time + outputs.pumpDelay, [&]() { sm.next(); });
+    }
+
     void Idle::enter(KPStateMachine & sm) {
         auto & app = *static_cast<App *>(sm.controller);
+        app.actuator.release();
         println(app.scheduleNextActiveTask().description());
     }
 
     void Stop::enter(KPStateMachine & sm) {
         auto & app = *static_cast<App *>(sm.controller);
+        app.actuator.release();
         app.pump.off();
         app.shift.writeAllRegistersLow();
         app.intake.off();
+        app.detailLog.close();
 
         app.vm.setValveStatus(app.status.currentValve, ValveStatus::sampled);
         app.vm.writeToDirectory();
 
         auto currentTaskId = app.currentTaskId;
         app.tm.advanceTask(currentTaskId);
-        app.tm.writeToDirectory();
+        app.tm.writeChangesToJournal();
+
+        // Both pipelines end here. Idle plans the next task and App::update serves any
+        // pending WiFi request once neither is running.
+        if (&sm == &app.nowTaskStateController) {
+            app.sampleNowActive = false;
+            app.ntm.markTaskAsCompleted();
+        }
 
         app.currentTaskId       = 0;
         app.status.currentValve = -1;
         sm.next();
     }
 
-    void Flush::enter(KPStateMachine & sm) {
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.intake.on();
-        // 5 seconds needed to turn ball intake on
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-            app.shift.write();
-        });
-        //wait 1 second after valve opens before during on pump
-        setTimeCondition(6, [&app](){
-            app.pump.on();
-        });
-
-
-        // To next state after 10 secs
-        setTimeCondition(time + 6, [&]() { sm.next(); });
-    }
-
-    void Flush::update(KPStateMachine & sm) {
-        //don't update valve status during first 5 seconds
-        //because valve isn't supposed to be on
-        if(timeSinceLastTransition() < 5000){
-            return;
-        }
-        // returns if it has already updated in the last second
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-        app.shift.write();
-    }
-
     void Flush::leave(KPStateMachine & sm) {
         auto & app = *static_cast<App *>(sm.controller);
         app.pump.off();
@@ -70,81 +53,21 @@ namespace SharedStates {
 
     void FlushVolume::enter(KPStateMachine & sm) {
         auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.intake.on();
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-            app.shift.write();
-            app.pump.on();
-        });
-
-        setTimeCondition(6, [&app](){
-            app.pump.on();
-        });
+        OutputState::enter(sm);
 
         auto condition = [&]() { return app.status.waterVolume >= 500; };
         setCondition(condition, [&]() { sm.next(1); });
-        setTimeCondition(time + 6, [&]() { sm.next(); });
-    }
-
-    void FlushVolume::update(KPStateMachine & sm) {
-        if(timeSinceLastTransition() < 5000){
-            return;
-        }
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-        app.shift.write();
-    }
-
-
-    void AirFlush::enter(KPStateMachine & sm) {
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.writeAllRegistersLow();
-        app.shift.setPin(TPICDevices::AIR_VALVE, HIGH);
-        app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-        app.shift.write();
-
-        setTimeCondition(1, [&app](){
-            app.pump.on();
-        });
-
-        setTimeCondition(time + 1, [&]() { sm.next(); });
-    }
-
-    void AirFlush::update(KPStateMachine & sm) {
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-        app.shift.write();
     }
 
     void Sample::enter(KPStateMachine & sm) {
-        // We set the latch valve to intake mode, turn on the filter valve, then the pump
+        // The actuator sets the ball intake to intake mode, opens the filter valve, then
+        // starts the pump
         auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.intake.on();
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(app.currentValveIdToPin(), HIGH);
-            app.shift.write();
-        });
+        applyOutputs(sm);
 
-        setTimeCondition(6,  [&app](){
-           app.pump.on(); 
-        });
-        
         app.sensors.flow.resetVolume();
         app.sensors.flow.startMeasurement();
+        app.sensors.setBaroResolution(ProgramSettings::BARO_SAMPLE_RESOLUTION);
 
         app.status.maxPressure = 0;
         this->condition        = nullptr;
@@ -152,7 +75,7 @@ namespace SharedStates {
         // This condition will be evaluated repeatedly until true then the callback will be executed
         // once
         auto const condition = [&]() {
-            if (app.sensors.flow.volume >= volume) {
+            if (app.sensors.flow.measuredVolume() >= volume) {
                 this->condition = "volume";
             }
 
@@ -160,7 +83,8 @@ namespace SharedStates {
                 this->condition = "pressure";
             }
 
-            if (timeSinceLastTransition() - 6 >= secsToMillis(time)) { //minus 6 to account for delay
+            // Sample time counts from when the pump starts
+            if (timeSinceLastTransition() >= secsToMillis(time + outputs.pumpDelay)) {
                 this->condition = "time";
             }
 
@@ -170,100 +94,28 @@ namespace SharedStates {
         setCondition(condition, [&]() { sm.next(); });
     }
 
-    void Sample::update(KPStateMachine & sm){
-        if(timeSinceLastTransition() < 5000){
-            return;
-        }
-
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
+    void Sample::leave(KPStateMachine & sm) {
         auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(app.currentValveIdToPin(), HIGH);
-        app.shift.write();
-    }
-
-    void Dry::enter(KPStateMachine & sm) {
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.intake.off();
-
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(TPICDevices::AIR_VALVE, HIGH);
-            app.shift.setPin(app.currentValveIdToPin(), HIGH);
-            app.shift.write();
-        });
-
-        setTimeCondition(6, [&app](){
-            app.pump.on();
-        });
-
-        setTimeCondition(time + 6, [&]() { sm.next(); });
-    }
-
-    void Dry::update(KPStateMachine & sm) {
-        if(timeSinceLastTransition() < 5000){
-            return;
-        }
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(TPICDevices::AIR_VALVE, HIGH);
-        app.shift.setPin(app.currentValveIdToPin(), HIGH);
-        app.shift.write();
+        app.sensors.setBaroResolution(ProgramSettings::BARO_IDLE_RESOLUTION);
     }
 
     void OffshootClean::enter(KPStateMachine & sm) {
         auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();  // Reset shift registers
-        app.pump.off();
-        app.intake.on();
-       // Delay to ensure ball intake is set properly
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(app.currentValveIdToPin(), HIGH);
-            app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-            app.shift.write();
-        });
-
-        setTimeCondition(6, [&app](){
-            app.pump.on(Direction::reverse);
-        });
+        applyOutputs(sm);
 
         //turn off pump right before state transition (leave function would be harder to have time delay)
-        setTimeCondition(time + 6, [&app](){
+        setTimeCondition(time + outputs.pumpDelay, [&app](){
             app.pump.off();
         });
 
-        setTimeCondition(time + 7, [&]() { sm.next(); });
+        setTimeCondition(time + outputs.pumpDelay + 1, [&]() { sm.next(); });
     };
 
-    void OffshootClean::update(KPStateMachine & sm){
-        if( timeSinceLastTransition() < 5000){
-            return;
-        }
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(app.currentValveIdToPin(), HIGH);
-        app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-        app.shift.write();
-    }
-
     void OffshootPreload::enter(KPStateMachine & sm) {
         // Intake valve is opened and the motor is runnning ...
         // Turnoff only the flush valve
         auto & app = *static_cast<App *>(sm.controller);
+        app.actuator.release();
         app.shift.setPin(TPICDevices::FLUSH_VALVE, LOW);
         app.shift.write();
         app.intake.on();
@@ -316,69 +168,4 @@ namespace SharedStates {
         });
     };
 
-    void Preserve::enter(KPStateMachine & sm) {
-        auto & app = *static_cast<App *>(sm.controller);
-        app.pump.off();
-        app.shift.writeAllRegistersLow();
-        app.intake.off();
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(TPICDevices::ALCHOHOL_VALVE, HIGH);
-            app.shift.setPin(app.currentValveIdToPin(), HIGH);
-            app.shift.write();
-        });
-
-        setTimeCondition(6, [&app](){
-            app.pump.on();
-        });
-        setTimeCondition(time + 6, [&]() { sm.next(); });
-    }
-
-
-    void Preserve::update(KPStateMachine & sm){
-        if(timeSinceLastTransition() < 5000){
-            return;
-        }
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(TPICDevices::ALCHOHOL_VALVE, HIGH);
-        app.shift.setPin(app.currentValveIdToPin(), HIGH);
-        app.shift.write();
-    }
-  
-    void AlcoholPurge::enter(KPStateMachine & sm) {
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.writeAllRegistersLow();
-        app.intake.off();
-        setTimeCondition(5, [&app](){
-            app.shift.setPin(TPICDevices::ALCHOHOL_VALVE, HIGH);
-            app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-            app.shift.write();
-        });
-        setTimeCondition(6, [&app](){
-            app.pump.on();
-        });
-        setTimeCondition(time + 6, [&]() { sm.next(); });
-    }
-
-    void AlcoholPurge::update(KPStateMachine & sm){
-        if(timeSinceLastTransition() < 5000){
-            return;
-        }
-        if ((unsigned long) (millis() - updateTime) < updateDelay) {
-            return;
-        }
-
-        updateTime = millis();
-        auto & app = *static_cast<App *>(sm.controller);
-        app.shift.setAllRegistersLow();
-        app.shift.setPin(TPICDevices::ALCHOHOL_VALVE, HIGH);
-        app.shift.setPin(TPICDevices::FLUSH_VALVE, HIGH);
-        app.shift.write();
-    }
-
-}  // namespace SharedStates
\ No newline at end of file
+}  // namespace SharedStates
@@ -1,7 +1,28 @@
 #pragma once
 #include <KPState.hpp>
+#include <Components/Actuator.hpp>
 
 namespace SharedStates {
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Base for states that hold a set of outputs for a fixed time. Entering the
+     *  state hands the outputs to App::actuator and moves to the next state `time`
+     *  seconds after the pump starts.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    class OutputState : public KPState {
+    public:
+        unsigned long time = 0;
+        OutputSet outputs;
+
+        OutputState(const OutputSet & outputs, unsigned long time)
+            : time(time), outputs(outputs) {}
+
+        void enter(KPStateMachine & sm) override;
+
+    protected:
+        void applyOutputs(KPStateMachine & sm);
+    };
+
     /** ────────────────────────────────────────────────────────────────────────────
      *
      *
@@ -26,13 +47,9 @@ namespace SharedStates {
      *
      *	@param time Flush time
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class Flush : public KPState {
+    class Flush : public OutputState {
     public:
-        unsigned long time = 10;
-        void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
+        Flush() : OutputState({device(TPICDevices::FLUSH_VALVE), false, IntakePosition::on}, 10) {}
         void leave(KPStateMachine & sm) override;
     };
 
@@ -40,73 +57,62 @@ namespace SharedStates {
      *
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class FlushVolume : public KPState {
+    class FlushVolume : public OutputState {
     public:
-        unsigned long time   = 10;
         unsigned long volume = 1000;
+        FlushVolume()
+            : OutputState({device(TPICDevices::FLUSH_VALVE), false, IntakePosition::on}, 10) {}
         void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
     };
 
     /** ────────────────────────────────────────────────────────────────────────────
      *
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class AirFlush : public KPState {
+    class AirFlush : public OutputState {
     public:
-        unsigned long time = 15;
-        void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
+        AirFlush()
+            : OutputState({device(TPICDevices::AIR_VALVE) | device(TPICDevices::FLUSH_VALVE),
+                           false, IntakePosition::unchanged, PumpMode::normal, 0, 1},
+                          15) {}
     };
 
     /** ────────────────────────────────────────────────────────────────────────────
      *
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class Sample : public KPState {
+    class Sample : public OutputState {
     public:
-        unsigned long time = 150;
-        float pressure     = 8;
-        float volume       = 1000;
+        float pressure = 8;
+        float volume   = 1000;
 
         const char * condition;
 
+        Sample() : OutputState({0, true, IntakePosition::on}, 150) {}
         void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
+        void leave(KPStateMachine & sm) override;
     };
 
     /** ────────────────────────────────────────────────────────────────────────────
      *
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class Dry : public KPState {
+    class Dry : public OutputState {
     public:
-        unsigned long time = 10;
-        void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
+        Dry() : OutputState({device(TPICDevices::AIR_VALVE), true, IntakePosition::off}, 10) {}
     };
 
     /** ────────────────────────────────────────────────────────────────────────────
      *
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class OffshootClean : public KPState {
+    class OffshootClean : public OutputState {
     public:
-        unsigned long time = 5;
-        OffshootClean(unsigned long time) : time(time) {}
+        OffshootClean(unsigned long time)
+            : OutputState({device(TPICDevices::FLUSH_VALVE), true, IntakePosition::on,
+                           PumpMode::reverse},
+                          time) {}
         void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
-        //void leave(KPStateMachine & sm) override;
     };
 
     /** ────────────────────────────────────────────────────────────────────────────
@@ -123,25 +129,21 @@ namespace SharedStates {
      *
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class Preserve : public KPState {
+    class Preserve : public OutputState {
     public:
-        unsigned long time = 0;
-        void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
+        Preserve()
+            : OutputState({device(TPICDevices::ALCHOHOL_VALVE), true, IntakePosition::off}, 0) {}
     };
 
     /** ────────────────────────────────────────────────────────────────────────────
      *  A state used to remove air bubbles from a alcohol bag
      *
      *  ──────────────────────────────────────────────────────────────────────────── */
-    class AlcoholPurge : public KPState {
+    class AlcoholPurge : public OutputState {
     public:
-        unsigned long time = 0;
-        void enter(KPStateMachine & sm) override;
-        unsigned long updateTime = millis();
-        unsigned long updateDelay = 1000;
-        void update(KPStateMachine & sm) override;
+        AlcoholPurge()
+            : OutputState({device(TPICDevices::ALCHOHOL_VALVE) | device(TPICDevices::FLUSH_VALVE),
+                           false, IntakePosition::off},
+                          0) {}
     };
 }  // namespace SharedStates
@@ -9,12 +9,12 @@
 #include <Utilities/JsonFileLoader.hpp>
 
 #include <Task/TaskStatus.hpp>
-#include <StateControllers/NowTaskStateController.hpp>
+#include <StateControllers/PipelineStateController.hpp>
 
 struct NowTask : public JsonEncodable,
               public JsonDecodable,
               public Printable,
-              public NowTaskStateController::Configurator {
+              public PipelineStateController::Configurator {
 public:
     friend class NowTaskManager;
 
@@ -37,6 +37,9 @@ public:
     int preserveTime   = 0;
 
     bool deleteOnCompletion = false;
+
+    // Stages to run, empty for Pipeline::Sequence::standard()
+    Pipeline::Sequence pipeline;
     int valve = 0;
 //    std::vector<uint8_t> valves;
 
@@ -71,7 +74,7 @@ public:
     }
 
     static constexpr size_t decodingSize() {
-        return ProgramSettings::TASK_JSON_BUFFER_SIZE;
+        return ProgramSettings::TASK_JSON_BUFFER_SIZE + Pipeline::Sequence::jsonSize();
     }
 
     void decodeJSON(const JsonVariant & source) override {
@@ -96,6 +99,10 @@ public:
         dryTime        = source[DRY_TIME];
         preserveTime   = source[PRESERVE_TIME];
         valve         = source[CURR_VALVE];
+
+        if (source.containsKey(PIPELINE)) {
+            pipeline.decodeJSON(source[PIPELINE]);
+        }
     }
 #pragma endregion
 #pragma region JSONENCODABLE
@@ -105,7 +112,7 @@ public:
     }
 
     static constexpr size_t encodingSize() {
-        return ProgramSettings::TASK_JSON_BUFFER_SIZE;
+        return ProgramSettings::TASK_JSON_BUFFER_SIZE + Pipeline::Sequence::jsonSize();
     }
 
     bool encodeJSON(const JsonVariant & dst) const override {
@@ -121,7 +128,8 @@ public:
 			&& dst[SAMPLE_VOLUME].set(sampleVolume)
 			&& dst[DRY_TIME].set(dryTime) 
 			&& dst[PRESERVE_TIME].set(preserveTime)
-			&& dst[CURR_VALVE].set(valve);
+			&& dst[CURR_VALVE].set(valve)
+			&& pipeline.encodeJSON(dst.createNestedArray(PIPELINE));
 	}  // clang-format on
 
     size_t printTo(Print & printer) const override {
@@ -132,21 +140,13 @@ public:
     }
 #pragma endregion
 
-    void operator()(NowTaskStateController::Config & config) const {
-        config.flushTime      = flushTime;
-        config.sampleTime     = sampleTime;
-        config.samplePressure = samplePressure;
-        config.sampleVolume   = sampleVolume;
-        config.dryTime        = dryTime;
-        config.preserveTime   = preserveTime;
-    }
-
-    void operator()(TaskStateController::Config & config) const {
+    void operator()(PipelineStateController::Config & config) const {
         config.flushTime      = flushTime;
         config.sampleTime     = sampleTime;
         config.samplePressure = samplePressure;
         config.sampleVolume   = sampleVolume;
         config.dryTime        = dryTime;
         config.preserveTime   = preserveTime;
+        config.pipeline       = pipeline.empty() ? Pipeline::Sequence::standard() : pipeline;
     }
 };
\ No newline at end of file
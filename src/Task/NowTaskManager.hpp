@@ -107,6 +107,19 @@ public:
         }
         return true;
     }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Same output as encodeJSON, serialized straight into `out`. See
+     *  TaskManager::streamJSON.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool streamJSON(Print & out) const {
+        StaticJsonDocument<NowTask::encodingSize()> entry;
+        const bool success = task.encodeJSON(entry.to<JsonVariant>());
+        out.print('[');
+        serializeJson(entry, out);
+        out.print(']');
+        return success;
+    }
 #pragma endregion
 #pragma region PRINTABLE
     size_t printTo(Print & p) const {
@@ -0,0 +1,113 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <ArduinoJson.h>
+
+#include <Application/Constants.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: R E C U R R E N C E : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// When a task samples again after each run. Every run consumes the next valve of the task
+// and the following schedule is computed from the rule only once that run is over, so a
+// deployment of several weeks is still a single stored task.
+//
+//   {"rule":"interval","every":3600}        every hour, anchored on the first schedule
+//   {"rule":"daily","at":"06:30","count":7} every day at 06:30 (RTC time), seven runs
+//   {"count":3}                             timeBetween spacing, three runs
+//
+// Runs stop when the count is reached (0 = no limit) or when the task runs out of valves.
+//
+struct Recurrence {
+    enum Rule : uint8_t { none, interval, daily };
+
+    static constexpr long secondsPerDay = 86400;
+
+    Rule rule  = none;
+    long every = 0;  // seconds between runs, interval only
+    int at     = 0;  // minutes past midnight, daily only
+    int count  = 0;  // number of runs, 0 for no limit
+    int done   = 0;  // runs completed so far
+
+    bool isExhausted() const {
+        return count > 0 && done >= count;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Earliest occurrence at or after `earliest`. Occurrences that were missed
+     *  (ex: the board was off) are skipped rather than run back to back.
+     *
+     *  @param anchor Schedule of the run that just completed
+     *  @param earliest Lower bound for the next schedule
+     *  @return long next schedule in seconds, or -1 if there is no time rule
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    long next(long anchor, long earliest) const {
+        switch (rule) {
+        case interval: {
+            if (anchor + every >= earliest) {
+                return anchor + every;
+            }
+
+            const long periods = (earliest - anchor + every - 1) / every;
+            return anchor + periods * every;
+        }
+        case daily: {
+            const long time = earliest - earliest % secondsPerDay + at * 60L;
+            return time >= earliest ? time : time + secondsPerDay;
+        }
+        default:
+            return -1;
+        }
+    }
+
+    static constexpr size_t jsonSize() {
+        return JSON_OBJECT_SIZE(5) + 24;
+    }
+
+    void decodeJSON(const JsonObject & source) {
+        using namespace TaskKeys;
+
+        const char * key = source[REPEAT_RULE] | "";
+        if (strcmp(key, "interval") == 0) {
+            rule = interval;
+        } else if (strcmp(key, "daily") == 0) {
+            rule = daily;
+        } else {
+            rule = none;
+        }
+
+        every = source[REPEAT_EVERY] | 0L;
+        count = source[REPEAT_COUNT] | 0;
+        done  = source[REPEAT_DONE] | 0;
+
+        int hours   = 0;
+        int minutes = 0;
+        at          = 0;
+        if (sscanf(source[REPEAT_AT] | "", "%d:%d", &hours, &minutes) == 2) {
+            at = constrain(hours, 0, 23) * 60 + constrain(minutes, 0, 59);
+        }
+
+        if (rule == interval && every <= 0) {
+            println(RED("Ignoring interval recurrence without period"));
+            rule = none;
+        }
+    }
+
+    bool encodeJSON(const JsonObject & dest) const {
+        using namespace TaskKeys;
+
+        const bool success = dest[REPEAT_COUNT].set(count) && dest[REPEAT_DONE].set(done);
+        switch (rule) {
+        case interval:
+            return success && dest[REPEAT_RULE].set("interval") && dest[REPEAT_EVERY].set(every);
+        case daily: {
+            char time[12];
+            snprintf(time, sizeof(time), "%02d:%02d", at / 60, at % 60);
+            return success && dest[REPEAT_RULE].set("daily") && dest[REPEAT_AT].set(time);
+        }
+        default:
+            return success;
+        }
+    }
+};
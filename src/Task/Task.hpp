@@ -9,12 +9,13 @@
 #include <Utilities/JsonFileLoader.hpp>
 
 #include <Task/TaskStatus.hpp>
-#include <StateControllers/TaskStateController.hpp>
+#include <Task/Recurrence.hpp>
+#include <StateControllers/PipelineStateController.hpp>
 
 struct Task : public JsonEncodable,
               public JsonDecodable,
               public Printable,
-              public TaskStateController::Configurator {
+              public PipelineStateController::Configurator {
 public:
     friend class TaskManager;
 
@@ -38,6 +39,12 @@ public:
 
     bool deleteOnCompletion = false;
 
+    // Stages to run, empty for Pipeline::Sequence::standard()
+    Pipeline::Sequence pipeline;
+
+    // When to run again after each valve. Without a rule, runs are timeBetween apart.
+    Recurrence repeat;
+
     std::vector<uint8_t> valves;
 
 public:
@@ -46,7 +53,9 @@ public:
 public:
     Task()                   = default;
     Task(const Task & other) = default;
+    Task(Task && other)      = default;
     Task & operator=(const Task &) = default;
+    Task & operator=(Task &&) = default;
 
     explicit Task(const JsonObject & data) {
         decodeJSON(data);
@@ -79,7 +88,8 @@ public:
     }
 
     static constexpr size_t decodingSize() {
-        return ProgramSettings::TASK_JSON_BUFFER_SIZE;
+        return ProgramSettings::TASK_JSON_BUFFER_SIZE + Pipeline::Sequence::jsonSize()
+               + Recurrence::jsonSize();
     }
 
     void decodeJSON(const JsonVariant & source) override {
@@ -117,6 +127,14 @@ public:
         dryTime        = source[DRY_TIME];
         preserveTime   = source[PRESERVE_TIME];
         timeBetween    = source[TIME_BETWEEN];
+
+        if (source.containsKey(PIPELINE)) {
+            pipeline.decodeJSON(source[PIPELINE]);
+        }
+
+        if (source.containsKey(REPEAT)) {
+            repeat.decodeJSON(source[REPEAT]);
+        }
     }
 #pragma endregion
 #pragma region JSONENCODABLE
@@ -126,7 +144,8 @@ public:
     }
 
     static constexpr size_t encodingSize() {
-        return ProgramSettings::TASK_JSON_BUFFER_SIZE;
+        return ProgramSettings::TASK_JSON_BUFFER_SIZE + Pipeline::Sequence::jsonSize()
+               + Recurrence::jsonSize();
     }
 
     bool encodeJSON(const JsonVariant & dst) const override {
@@ -148,6 +167,8 @@ public:
 			&& dst[TIME_BETWEEN].set(timeBetween) 
 			&& dst[VALVES_OFFSET].set(getValveOffsetStart())
 			&& dst[DELETE].set(deleteOnCompletion)
+			&& pipeline.encodeJSON(dst.createNestedArray(PIPELINE))
+			&& repeat.encodeJSON(dst.createNestedObject(REPEAT))
 			&& copyArray(valves.data(), valves.size(), dst.createNestedArray(VALVES));
 	}  // clang-format on
 
@@ -159,12 +180,13 @@ public:
     }
 #pragma endregion
 
-    void operator()(TaskStateController::Config & config) const {
+    void operator()(PipelineStateController::Config & config) const {
         config.flushTime      = flushTime;
         config.sampleTime     = sampleTime;
         config.samplePressure = samplePressure;
         config.sampleVolume   = sampleVolume;
         config.dryTime        = dryTime;
         config.preserveTime   = preserveTime;
+        config.pipeline       = pipeline.empty() ? Pipeline::Sequence::standard() : pipeline;
     }
 };
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <string.h>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: T A S K   J O U R N A L   O P : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Kind of mutation recorded in the task journal. Each journal entry is one line of JSON:
+//
+//   {"op":"create","task":{...}}   full task object, inserted or replaced on replay
+//   {"op":"update","task":{...}}   same as create
+//   {"op":"status","id":1,"status":2}
+//   {"op":"delete","id":1}
+//
+class TaskJournalOp {
+public:
+    enum Code { create, update, status, remove } _code;
+
+public:
+    TaskJournalOp(Code code) : _code(code) {}
+
+    Code code() const {
+        return _code;
+    }
+
+    const char * c_str() const {
+        switch (_code) {
+        case create:
+            return "create";
+        case update:
+            return "update";
+        case status:
+            return "status";
+        case remove:
+            return "delete";
+        default:
+            halt(TRACE, "Unknown case");
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Parse the op name stored in the journal
+     *
+     *  @param name Op name (ex: "create", "update", "status", "delete")
+     *  @param op Receives the parsed op
+     *  @return true if the name is recognized
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static bool fromString(const char * name, Code & op) {
+        if (name == nullptr) {
+            return false;
+        }
+
+        for (auto code : {create, update, status, remove}) {
+            if (strcmp(name, TaskJournalOp(code).c_str()) == 0) {
+                op = code;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Implicit conversion to int
+    operator int() const {
+        return _code;
+    }
+};
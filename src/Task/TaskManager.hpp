@@ -5,8 +5,15 @@
 
 #include <Task/Task.hpp>
 #include <Task/TaskObserver.hpp>
+#include <Task/TaskJournalOp.hpp>
+#include <Task/TaskQuery.hpp>
 #include <Application/Config.hpp>
+#include <Utilities/Log.hpp>
+#include <Utilities/StoreGeneration.hpp>
 
+#include <algorithm>
+#include <set>
+#include <utility>
 #include <vector>
 #include "SD.h"
 
@@ -17,8 +24,22 @@ class TaskManager : public KPComponent,
 public:
     using CollectionType = std::unordered_map<int, Task>;
     using EntryType      = CollectionType::value_type;
+    using ScheduleIndex  = std::set<std::pair<long, int>>;
     CollectionType tasks;
 
+private:
+    // Mutations since the last journal write, coalesced per task id
+    std::unordered_map<int, TaskJournalOp::Code> pendingChanges;
+
+    // Active tasks ordered by (schedule, id) and the key each one is currently filed under.
+    // Kept in sync by every mutation below. Code that changes the schedule or status of a task
+    // in place must call markTaskAsModified.
+    ScheduleIndex activeSchedule;
+    std::unordered_map<int, long> indexedSchedules;
+
+    // Incremented by every mutation and every reload, exposed as the ETag of /api/tasks
+    unsigned long changes = 0;
+
 public:
     const char * taskFolder = nullptr;
 
@@ -45,18 +66,45 @@ public:
         return tasks;
     }
 
+    unsigned long version() const {
+        return changes;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Active tasks as (schedule, id) pairs, earliest first
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    const ScheduleIndex & activeTaskSchedule() const {
+        return activeSchedule;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Id of the active task with the earliest schedule
+     *
+     *  @return int task id or 0 if there is no active task
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    int nextActiveTaskId() const {
+        return activeSchedule.empty() ? 0 : activeSchedule.begin()->second;
+    }
+
     bool advanceTask(int id) {
         if (!findTask(id)) {
             return false;
         }
 
         auto & task = tasks[id];
-        println(GREEN("Task Time betwen: "), task.timeBetween);
-        task.schedule = now() + std::max(task.timeBetween, 5);
-        if (++task.valveOffsetStart >= task.getNumberOfValves()) {
+        task.repeat.done++;
+        if (++task.valveOffsetStart >= task.getNumberOfValves() || task.repeat.isExhausted()) {
             return markTaskAsCompleted(id);
         }
 
+        // The next run is only computed now so that a recurring task stays a single entry
+        const long timenow = now();
+        const long next    = task.repeat.next(task.schedule, timenow + 5);
+        task.schedule      = next >= 0 ? next : timenow + std::max(task.timeBetween, 5);
+        println(GREEN("Task next run: "), task.schedule);
+
+        reindex(task);
+        recordChange(id, TaskJournalOp::update);
         return true;
     }
 
@@ -66,14 +114,46 @@ public:
         }
 
         tasks[id].status = status;
+        reindex(tasks[id]);
+        recordChange(id, TaskJournalOp::status);
         updateObservers(&TaskObserver::taskDidUpdate, tasks[id]);
         return true;
     }
 
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Replace an existing task with incoming data
+     *
+     *  @param task Task object with the id of an existing task
+     *  @return bool true if the task exists and was replaced
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool updateTask(const Task & task) {
+        if (!findTask(task.id)) {
+            return false;
+        }
+
+        tasks[task.id] = task;
+        reindex(tasks[task.id]);
+        recordChange(task.id, TaskJournalOp::update);
+        updateObservers(&TaskObserver::taskDidUpdate, tasks[task.id]);
+        return true;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Record that a task was modified in place so that the next journal write
+     *  includes its full content
+     *
+     *  @param id Id of the modified task
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void markTaskAsModified(int id) {
+        auto found = tasks.find(id);
+        if (found != tasks.end()) {
+            reindex(found->second);
+            recordChange(id, TaskJournalOp::update);
+        }
+    }
+
     int numberOfActiveTasks() const {
-        return std::count_if(tasks.begin(), tasks.end(), [](const EntryType & kv) {
-            return kv.second.status == TaskStatus::active;
-        });
+        return activeSchedule.size();
     }
 
     bool markTaskAsCompleted(int id) {
@@ -85,10 +165,12 @@ public:
         auto & task = tasks[id];
         task.valves.clear();
         if (task.deleteOnCompletion) {
-            println("DELETED: ", id);
+            LOG_DEBUG(tasks, "Deleted ", id);
             deleteTask(id);
         } else {
             task.status = TaskStatus::completed;
+            reindex(task);
+            recordChange(id, TaskJournalOp::update);
             updateObservers(&TaskObserver::taskDidUpdate, task);
         }
 
@@ -101,6 +183,8 @@ public:
 
     bool deleteTask(int id) {
         if (tasks.erase(id)) {
+            unindex(id);
+            recordChange(id, TaskJournalOp::remove);
             updateObservers(&TaskObserver::taskDidDelete, id);
             return true;
         }
@@ -114,6 +198,8 @@ public:
             if (predicate(it->second)) {
                 auto id = it->first;
                 it      = tasks.erase(it);
+                unindex(id);
+                recordChange(id, TaskJournalOp::remove);
                 updateObservers(&TaskObserver::taskDidDelete, id);
             } else {
                 it++;
@@ -124,7 +210,9 @@ public:
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  @brief Load all tasks object from the specified directory in the SD card
+     *  @brief Load all tasks object from the specified directory in the SD card, then
+     *  replay the journal on top. If the journal had any entry, even a damaged one, the
+     *  result is compacted back into task files and the journal is removed.
      *
      *  @param _dir Path to tasks directory (default=~/tasks)
      *  ──────────────────────────────────────────────────────────────────────────── */
@@ -134,71 +222,278 @@ public:
         JsonFileLoader loader;
         loader.createDirectoryIfNeeded(dir);
 
-        // Load task index file and get the number of tasks
-        KPStringBuilder<32> indexFilepath(dir, "/index.js");
-        StaticJsonDocument<100> indexFile;
-        loader.load(indexFilepath, indexFile);
+        // Load task index file and get the number of tasks and the file set holding them
+        int count, set;
+        readIndexFile(dir, count, set);
 
         // Decode each task object into memory
-        int count  = indexFile["count"];
         auto start = millis();
         for (int i = 0; i < count; i++) {
-            KPStringBuilder<32> filepath(dir, "/task-", i, ".js");
+            KPStringBuilder<32> filepath(dir, "/", taskFilePrefix(set), i, ".js");
             Task task;
             loader.load(filepath, task);
-            tasks.insert({task.id, task});
+            const int id = task.id;
+            tasks.emplace(id, std::move(task));
         }
 
         println(GREEN("Task Manager"), " finished reading in ", millis() - start, " ms\n");
         // updateObservers(&TaskObserver::taskCollectionDidUpdate, tasks.begin());
+
+        KPStringBuilder<32> journalFilepath(dir, "/", ProgramSettings::TASK_JOURNAL_FILE);
+        if (replayJournal(journalFilepath) > 0) {
+            // See writeToDirectory: the journal is only removed once the compacted files are
+            // in use, and replaying it again over them yields the same result.
+            if (writeToDirectory(dir)) {
+                SD.remove(journalFilepath);
+            }
+        }
+
+        rebuildIndex();
+        pendingChanges.clear();
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  @brief Get the Active Task Ids sorted by their schedules (<)
+     *  @brief Replace the task collection with tasks that were already decoded (ex: from
+     *  the boot snapshot). The tasks are moved, not copied, and nothing is journaled.
      *
-     *  @return std::vector<int> list of ids
+     *  @param restored Tasks to take over
      *  ──────────────────────────────────────────────────────────────────────────── */
-    std::vector<int> getActiveSortedTaskIds() {
-        std::vector<int> result;
-        result.reserve(tasks.size());
+    void restoreTasks(std::vector<Task> & restored) {
+        tasks.clear();
+        for (auto & task : restored) {
+            const int id = task.id;
+            tasks.emplace(id, std::move(task));
+        }
 
-        for (const auto & kv : tasks) {
-            if (kv.second.status == TaskStatus::active) {
-                result.push_back(kv.first);
+        restored.clear();
+        rebuildIndex();
+        pendingChanges.clear();
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Rewrite the task files and drop the journal once it grows past `limit`.
+     *  Loading from JSON compacts on every boot; this covers boots that skip it.
+     *
+     *  @param limit Journal size in bytes
+     *  @param _dir Path to tasks directory (default=~/tasks)
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void compactJournalIfLarger(uint32_t limit, const char * _dir = nullptr) {
+        const char * dir = _dir ? _dir : taskFolder;
+
+        KPStringBuilder<32> journalFilepath(dir, "/", ProgramSettings::TASK_JOURNAL_FILE);
+        File file = SD.open(journalFilepath, FILE_READ);
+        if (!file) {
+            return;
+        }
+
+        const uint32_t size = file.size();
+        file.close();
+        if (size > limit && writeToDirectory(dir)) {
+            SD.remove(journalFilepath);
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Apply journal entries to the task collection in the order they were written.
+     *  An entry that cannot be parsed (ex: a torn append from power loss) is skipped up to
+     *  the end of its line, see writeChangesToJournal, and the entries after it still apply.
+     *
+     *  @param filepath Path to the journal file
+     *  @return int Number of entries read, applied or skipped
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    int replayJournal(const char * filepath) {
+        File file = SD.open(filepath, FILE_READ);
+        if (!file) {
+            return 0;
+        }
+
+        auto start  = millis();
+        int applied = 0;
+        int skipped = 0;
+        StaticJsonDocument<Task::decodingSize() + 100> entry;
+        for (;;) {
+            // Line breaks between entries
+            for (int c = file.peek(); c == '\r' || c == '\n'; c = file.peek()) {
+                file.read();
+            }
+
+            if (!file.available()) {
+                break;
+            }
+
+            const uint32_t position = file.position();
+            if (deserializeJson(entry, file) != DeserializationError::Ok) {
+                LOG_ERROR(tasks, "Skipping damaged journal entry at ", position, " in ", filepath);
+                file.seek(position);
+                for (int c = file.read(); c >= 0 && c != '\n'; c = file.read()) {
+                }
+
+                skipped++;
+                continue;
             }
+
+            TaskJournalOp::Code op;
+            if (!TaskJournalOp::fromString(entry[JournalKeys::OP].as<const char *>(), op)) {
+                LOG_ERROR(tasks, "Skipping unknown journal entry at ", position, " in ", filepath);
+                skipped++;
+                continue;
+            }
+
+            switch (op) {
+            case TaskJournalOp::create:
+            case TaskJournalOp::update: {
+                Task task;
+                task.decodeJSON(entry[JournalKeys::TASK]);
+                const int id = task.id;
+                tasks[id]    = std::move(task);
+            } break;
+            case TaskJournalOp::status: {
+                auto found = tasks.find(entry[JournalKeys::ID].as<int>());
+                if (found != tasks.end()) {
+                    found->second.status = entry[JournalKeys::STATUS].as<int>();
+                }
+            } break;
+            case TaskJournalOp::remove:
+                tasks.erase(entry[JournalKeys::ID].as<int>());
+                break;
+            }
+
+            applied++;
         }
 
-        std::sort(result.begin(), result.end(),
-                  [this](int a, int b) { return tasks[a].schedule < tasks[b].schedule; });
+        file.close();
+        if (applied > 0) {
+            rebuildIndex();
+        }
+
+        println(GREEN("Task Manager"), " replayed ", applied, " journal entries in ",
+                millis() - start, " ms, skipped ", skipped, "\n");
+        return applied + skipped;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Append one journal entry per changed task since the last call. The cost
+     *  depends only on the number of changes, not on the number of tasks.
+     *
+     *  @param _dir Path to tasks directory (default=~/tasks)
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void writeChangesToJournal(const char * _dir = nullptr) {
+        if (pendingChanges.empty()) {
+            return;
+        }
+
+        const char * dir = _dir ? _dir : taskFolder;
+        StoreGeneration::bump();
+
+        JsonFileLoader loader;
+        loader.createDirectoryIfNeeded(dir);
+
+        auto start = millis();
+        KPStringBuilder<32> journalFilepath(dir, "/", ProgramSettings::TASK_JOURNAL_FILE);
+        File file = SD.open(journalFilepath, FILE_WRITE);
+        if (!file) {
+            LOG_ERROR(tasks, "Unable to open ", journalFilepath);
+            return;
+        }
+
+        // An append torn by power loss leaves the last line unfinished. Start a new line so
+        // that replayJournal only skips the torn entry.
+        const uint32_t size = file.size();
+        if (size > 0 && file.seek(size - 1) && file.read() != '\n') {
+            file.println();
+        }
+
+        StaticJsonDocument<Task::encodingSize() + 100> entry;
+        for (const auto & kv : pendingChanges) {
+            const int id           = kv.first;
+            const TaskJournalOp op = kv.second;
+            const auto found       = tasks.find(id);
+            if (op != TaskJournalOp::remove && found == tasks.end()) {
+                continue;
+            }
+
+            entry.clear();
+            entry[JournalKeys::OP] = op.c_str();
+            switch (op) {
+            case TaskJournalOp::create:
+            case TaskJournalOp::update:
+                found->second.encodeJSON(entry.createNestedObject(JournalKeys::TASK));
+                break;
+            case TaskJournalOp::status:
+                entry[JournalKeys::ID]     = id;
+                entry[JournalKeys::STATUS] = found->second.status;
+                break;
+            case TaskJournalOp::remove:
+                entry[JournalKeys::ID] = id;
+                break;
+            }
+
+            serializeJson(entry, file);
+            file.println();
+        }
+
+        file.close();
+        LOG_DEBUG(tasks, "Journaled ", pendingChanges.size(), " changes in ", millis() - start,
+                  " ms");
+        pendingChanges.clear();
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Get the Active Task Ids sorted by their schedules (<). Prefer
+     *  nextActiveTaskId or activeTaskSchedule which do not allocate.
+     *
+     *  @return std::vector<int> list of ids
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    std::vector<int> getActiveSortedTaskIds() const {
+        std::vector<int> result;
+        result.reserve(activeSchedule.size());
+        for (const auto & entry : activeSchedule) {
+            result.push_back(entry.second);
+        }
 
         return result;
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  @brief Insert task into TaskManager's internal data structure
+     *  @brief Insert a copy of the task into TaskManager's internal data structure
      *
-     *  @param task Task object to be inserted
+     *  @param task Task object to be inserted. Receives the new id if one was generated.
      *  @param forcedIdGeneration Forced ID generation if task.id already exists
      *  @return bool true on successful insertion, false otherwise
      *  ──────────────────────────────────────────────────────────────────────────── */
     bool insertTask(Task & task, bool forcedIdGeneration = false) {
-        if (forcedIdGeneration) {
-            while (!tasks.insert({task.id, task}).second) {
-                task.id = random(RAND_MAX);
-            }
+        if (!reserveTaskId(task, forcedIdGeneration)) {
+            return false;
+        }
 
-            return true;
+        emplaceTask(Task(task));
+        return true;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Move the task into TaskManager's internal data structure
+     *
+     *  @param task Task object to be inserted
+     *  @param forcedIdGeneration Forced ID generation if task.id already exists
+     *  @return bool true on successful insertion, false otherwise
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool insertTask(Task && task, bool forcedIdGeneration = false) {
+        if (!reserveTaskId(task, forcedIdGeneration)) {
+            return false;
         }
 
-        return tasks.insert({task.id, task}).second;
+        emplaceTask(std::move(task));
+        return true;
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
      *  @brief Update the index file containing info about tasks
      *
+     *  @param set File set holding the tasks, see taskFilePrefix
      *  @param _dir Path to tasks directory (default=~/tasks)
+     *  @return bool false if the index could not be written
      *  ──────────────────────────────────────────────────────────────────────────── */
-    void updateIndexFile(const char * _dir = nullptr) {
+    bool updateIndexFile(int set, const char * _dir = nullptr) {
         const char * dir = _dir ? _dir : taskFolder;
 
         JsonFileLoader loader;
@@ -207,33 +502,156 @@ public:
         KPStringBuilder<32> indexFilepath(dir, "/index.js");
         StaticJsonDocument<100> indexJson;
         indexJson["count"] = tasks.size();
-        loader.save(indexFilepath, indexJson);
+        indexJson["set"]   = set;
+        return loader.save(indexFilepath, indexJson);
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  @brief Write task array to SD directory
+     *  @brief Write task array to SD directory. This rewrites every task file and is
+     *  only used to compact the journal. Use writeChangesToJournal to persist mutations.
+     *
+     *  Safe to interrupt: the tasks go to the file set that index.js does not point to,
+     *  and index.js is switched to it last. Until then the old files and the journal
+     *  still describe every task. The old files are removed after the switch.
      *
      *  @param _dir Path to tasks directory (default=~/tasks)
+     *  @return bool true once index.js points to the new files
      *  ──────────────────────────────────────────────────────────────────────────── */
-    void writeToDirectory(const char * _dir = nullptr) {
+    bool writeToDirectory(const char * _dir = nullptr) {
         const char * dir = _dir ? _dir : taskFolder;
+        StoreGeneration::bump();
 
         JsonFileLoader loader;
         loader.createDirectoryIfNeeded(dir);
 
-        println("Number of tasks to write: ", tasks.size());
+        LOG_DEBUG(tasks, "Number of tasks to write: ", tasks.size());
+
+        int oldCount, oldSet;
+        readIndexFile(dir, oldCount, oldSet);
+        const int set = 1 - oldSet;
 
         int i = 0;
         for (auto & kv : tasks) {
-            KPStringBuilder<32> filename("task-", i, ".js");
-            KPStringBuilder<64> filepath(dir, "/", filename);
-            loader.save(filepath, kv.second);
+            KPStringBuilder<32> filepath(dir, "/", taskFilePrefix(set), i, ".js");
+            if (!loader.save(filepath, kv.second)) {
+                LOG_ERROR(tasks, "Compaction aborted, keeping ", taskFilePrefix(oldSet), "*");
+                return false;
+            }
+
             i++;
         }
 
-        updateIndexFile(dir);
+        if (!updateIndexFile(set, dir)) {
+            return false;
+        }
+
+        for (i = 0; i < oldCount; i++) {
+            KPStringBuilder<32> filepath(dir, "/", taskFilePrefix(oldSet), i, ".js");
+            SD.remove(filepath);
+        }
+
+        return true;
+    }
+
+private:
+    // Task files alternate between two sets so that compaction never overwrites the files
+    // in use. 8.3 names: up to 1000 tasks.
+    static const char * taskFilePrefix(int set) {
+        return set == 1 ? "tset-" : "task-";
+    }
+
+    static void readIndexFile(const char * dir, int & count, int & set) {
+        JsonFileLoader loader;
+        KPStringBuilder<32> indexFilepath(dir, "/index.js");
+        StaticJsonDocument<100> indexFile;
+        loader.load(indexFilepath, indexFile);
+
+        count = indexFile["count"] | 0;
+        set   = (indexFile["set"] | 0) == 1 ? 1 : 0;
+    }
+
+    bool reserveTaskId(Task & task, bool forcedIdGeneration) {
+        if (forcedIdGeneration) {
+            while (findTask(task.id)) {
+                task.id = random(RAND_MAX);
+            }
+
+            return true;
+        }
+
+        return !findTask(task.id);
+    }
+
+    void emplaceTask(Task && task) {
+        const int id = task.id;
+        auto & entry = tasks.emplace(id, std::move(task)).first->second;
+        reindex(entry);
+        recordChange(id, TaskJournalOp::create);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief File the task under its current schedule if it is active, or drop it from
+     *  the index otherwise. O(log n).
+     *
+     *  @param task Task stored in the collection
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void reindex(const Task & task) {
+        unindex(task.id);
+        if (task.status == TaskStatus::active) {
+            activeSchedule.emplace(task.schedule, task.id);
+            indexedSchedules[task.id] = task.schedule;
+        }
+    }
+
+    void unindex(int id) {
+        auto found = indexedSchedules.find(id);
+        if (found != indexedSchedules.end()) {
+            activeSchedule.erase({found->second, id});
+            indexedSchedules.erase(found);
+        }
+    }
+
+    void rebuildIndex() {
+        changes++;
+        activeSchedule.clear();
+        indexedSchedules.clear();
+        for (const auto & kv : tasks) {
+            reindex(kv.second);
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Remember a mutation for the next journal write. Multiple mutations to the
+     *  same task collapse into the one that carries the most information.
+     *
+     *  @param id Id of the mutated task
+     *  @param op Kind of mutation
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void recordChange(int id, TaskJournalOp::Code op) {
+        changes++;
+        auto found = pendingChanges.find(id);
+        if (found == pendingChanges.end()) {
+            pendingChanges[id] = op;
+            return;
+        }
+
+        auto & pending = found->second;
+        if (op == TaskJournalOp::remove) {
+            if (pending == TaskJournalOp::create) {
+                // Never reached the card, nothing to remove
+                pendingChanges.erase(found);
+            } else {
+                pending = TaskJournalOp::remove;
+            }
+        } else if (pending == TaskJournalOp::remove) {
+            // Id reused after deletion (ex: replaced task). Write the whole object.
+            pending = TaskJournalOp::update;
+        } else if (pending == TaskJournalOp::status) {
+            pending = op;
+        }
     }
 
+public:
 #pragma region JSONENCODABLE
     static const char * encoderName() {
         return "TaskManager";
@@ -253,6 +671,84 @@ public:
 
         return true;
     }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Visit the tasks matching the query in listing order: active tasks by
+     *  schedule through the index, others in collection order. Stops after the page.
+     *
+     *  @param callback Called with each task of the page
+     *  @return size_t number of matching tasks visited, including those before the page
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    template <typename Callback>
+    size_t forEachMatching(const TaskQuery & query, Callback && callback) const {
+        size_t position = 0;
+        auto visit      = [&](const Task & task) {
+            if (query.isWithinPage(position)) {
+                callback(task);
+            }
+
+            position++;
+            return query.limit == 0 || position < query.offset + query.limit;
+        };
+
+        if (query.status == TaskStatus::active) {
+            for (const auto & entry : activeSchedule) {
+                if (!visit(tasks.at(entry.second))) {
+                    break;
+                }
+            }
+        } else {
+            for (const auto & kv : tasks) {
+                if (query.matches(kv.second) && !visit(kv.second)) {
+                    break;
+                }
+            }
+        }
+
+        return position;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Number of tasks matching the query status, ignoring the page. O(1) for
+     *  active tasks.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    size_t countMatching(const TaskQuery & query) const {
+        if (query.status == TaskStatus::active) {
+            return activeSchedule.size();
+        }
+
+        if (query.status == TaskQuery::anyStatus) {
+            return tasks.size();
+        }
+
+        return std::count_if(tasks.begin(), tasks.end(),
+                             [&](const EntryType & kv) { return query.matches(kv.second); });
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Serialize the tasks selected by the query as one JSON array. Tasks are
+     *  encoded one at a time into the same document, so memory use doesn't grow with
+     *  the number of tasks.
+     *
+     *  @param out Destination, usually a ChunkedResponse
+     *  @param query Tasks and fields to encode, every task in full by default
+     *  @return true if every task was encoded
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool streamJSON(Print & out, const TaskQuery & query = TaskQuery{}) const {
+        StaticJsonDocument<Task::encodingSize()> entry;
+        bool success   = true;
+        char separator = '[';
+        forEachMatching(query, [&](const Task & task) {
+            entry.clear();
+            success = query.encode(task, entry.to<JsonVariant>()) && success;
+            out.print(separator);
+            serializeJson(entry, out);
+            separator = ',';
+        });
+
+        out.print(separator == '[' ? "[]" : "]");
+        return success;
+    }
 #pragma endregion
 #pragma region PRINTABLE
     size_t printTo(Print & p) const {
@@ -0,0 +1,161 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <ArduinoJson.h>
+
+#include <Application/Constants.hpp>
+#include <Task/Task.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: T A S K   Q U E R Y : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Which tasks to list and which of their fields to encode. Used by TaskManager::streamJSON
+// so the web UI only pays for the rows and columns it displays.
+//
+//   {"status":"active","offset":0,"limit":10,"fields":["id","name","schedule","status"]}
+//
+// Every key is optional: no status lists every task, a limit of 0 means no limit and no
+// fields encodes whole tasks.
+//
+struct TaskQuery {
+    static constexpr int anyStatus = -1;
+
+    int status    = anyStatus;
+    size_t offset = 0;
+    size_t limit  = 0;
+    uint32_t mask = 0;  // Bit i selects fields()[i], 0 for every field
+
+    struct Field {
+        const char * key;
+        bool (*encode)(const Task & task, const JsonVariant & dst);
+    };
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Encoders of every field of Task::encodeJSON, in the same order
+     *
+     *  @param count Set to the number of fields
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static const Field * fields(size_t & count) {
+        using namespace TaskKeys;
+        // clang-format off
+        static const Field table[] = {
+            {ID,              [](const Task & t, const JsonVariant & d) { return d[ID].set(t.id); }},
+            {NAME,            [](const Task & t, const JsonVariant & d) { return d[NAME].set((char *) t.name); }},
+            {NOTES,           [](const Task & t, const JsonVariant & d) { return d[NOTES].set((char *) t.notes); }},
+            {STATUS,          [](const Task & t, const JsonVariant & d) { return d[STATUS].set(t.status); }},
+            {CREATED_AT,      [](const Task & t, const JsonVariant & d) { return d[CREATED_AT].set(t.createdAt); }},
+            {SCHEDULE,        [](const Task & t, const JsonVariant & d) { return d[SCHEDULE].set(t.schedule); }},
+            {FLUSH_TIME,      [](const Task & t, const JsonVariant & d) { return d[FLUSH_TIME].set(t.flushTime); }},
+            {FLUSH_VOLUME,    [](const Task & t, const JsonVariant & d) { return d[FLUSH_VOLUME].set(t.flushVolume); }},
+            {SAMPLE_TIME,     [](const Task & t, const JsonVariant & d) { return d[SAMPLE_TIME].set(t.sampleTime); }},
+            {SAMPLE_PRESSURE, [](const Task & t, const JsonVariant & d) { return d[SAMPLE_PRESSURE].set(t.samplePressure); }},
+            {SAMPLE_VOLUME,   [](const Task & t, const JsonVariant & d) { return d[SAMPLE_VOLUME].set(t.sampleVolume); }},
+            {DRY_TIME,        [](const Task & t, const JsonVariant & d) { return d[DRY_TIME].set(t.dryTime); }},
+            {PRESERVE_TIME,   [](const Task & t, const JsonVariant & d) { return d[PRESERVE_TIME].set(t.preserveTime); }},
+            {TIME_BETWEEN,    [](const Task & t, const JsonVariant & d) { return d[TIME_BETWEEN].set(t.timeBetween); }},
+            {VALVES_OFFSET,   [](const Task & t, const JsonVariant & d) { return d[VALVES_OFFSET].set(t.getValveOffsetStart()); }},
+            {DELETE,          [](const Task & t, const JsonVariant & d) { return d[DELETE].set(t.deleteOnCompletion); }},
+            {PIPELINE,        [](const Task & t, const JsonVariant & d) { return t.pipeline.encodeJSON(d.createNestedArray(PIPELINE)); }},
+            {REPEAT,          [](const Task & t, const JsonVariant & d) { return t.repeat.encodeJSON(d.createNestedObject(REPEAT)); }},
+            {VALVES,          [](const Task & t, const JsonVariant & d) { return copyArray(t.valves.data(), t.valves.size(), d.createNestedArray(VALVES)); }},
+        };
+        // clang-format on
+
+        count = sizeof(table) / sizeof(table[0]);
+        return table;
+    }
+
+    bool matches(const Task & task) const {
+        return status == anyStatus || task.status == status;
+    }
+
+    bool isWithinPage(size_t position) const {
+        return position >= offset && (limit == 0 || position - offset < limit);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Encode the selected fields of the task
+     *
+     *  @return bool true if every selected field was encoded
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool encode(const Task & task, const JsonVariant & dst) const {
+        if (mask == 0) {
+            return task.encodeJSON(dst);
+        }
+
+        size_t count;
+        const Field * table = fields(count);
+        bool success        = true;
+        for (size_t i = 0; i < count; i++) {
+            if (mask & (1UL << i)) {
+                success = table[i].encode(task, dst) && success;
+            }
+        }
+
+        return success;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Select a field by its JSON key
+     *
+     *  @return bool false if no field has this key
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool select(const char * key) {
+        size_t count;
+        const Field * table = fields(count);
+        for (size_t i = 0; i < count; i++) {
+            if (strcmp(table[i].key, key) == 0) {
+                mask |= 1UL << i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Parse a status name (ex: "active") or code. "all" or "" matches any status.
+     *
+     *  @return bool false if the status is unknown
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool selectStatus(const char * text) {
+        static const char * names[] = {"inactive", "active", "completed", "missed"};
+        if (strcmp(text, "") == 0 || strcmp(text, "all") == 0) {
+            status = anyStatus;
+            return true;
+        }
+
+        for (int i = 0; i < int(sizeof(names) / sizeof(names[0])); i++) {
+            if (strcmp(text, names[i]) == 0 || (isdigit(text[0]) && atoi(text) == i)) {
+                status = i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Read the query from a request body. Unknown statuses and fields are
+     *  reported and ignored.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void decodeJSON(const JsonVariantConst & source) {
+        using namespace TaskQueryKeys;
+
+        JsonVariantConst statusSource = source[STATUS];
+        if (statusSource.is<int>()) {
+            status = statusSource.as<int>();
+        } else if (!selectStatus(statusSource | "")) {
+            println(RED("TaskQuery: unknown status "), statusSource.as<const char *>());
+        }
+
+        offset = std::max(source[OFFSET] | 0, 0);
+        limit  = std::max(source[LIMIT] | 0, 0);
+        for (const char * key : source[FIELDS].as<JsonArrayConst>()) {
+            if (key && !select(key)) {
+                println(RED("TaskQuery: unknown field "), key);
+            }
+        }
+    }
+};
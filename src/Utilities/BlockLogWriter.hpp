@@ -0,0 +1,170 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <SD.h>
+
+#include <Application/Constants.hpp>
+#include <Utilities/Log.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: B L O C K   L O G   W R I T E R : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Keeps one file handle open and collects rows in a fixed RAM ring. Rows only reach the SD
+// card in whole 512-byte sectors so the card never has to rewrite a partial sector. Anything
+// left in the ring is written out when the caller forces a flush or closes the writer.
+//
+template <size_t capacity>
+class BlockLogWriter {
+public:
+    static constexpr size_t sectorSize = 512;
+    static_assert(capacity >= sectorSize, "Ring must hold at least one sector");
+
+    struct Stats {
+        unsigned long rows    = 0;  // rows appended (each used to cost an open/flush/close)
+        unsigned long bytes   = 0;  // bytes handed to the SD card
+        unsigned long flushes = 0;  // number of times the file was flushed to the card
+    };
+
+    const char * filepath;
+    Stats stats;
+
+private:
+    File file;
+    bool opened = false;
+
+    char ring[capacity];
+    size_t head  = 0;  // index of the next byte to be written into the ring
+    size_t count = 0;  // number of bytes waiting in the ring
+
+    // Current end of file. Used to align flushes to the sector boundaries of the file
+    unsigned long filePosition = 0;
+
+public:
+    explicit BlockLogWriter(const char * filepath) : filepath(filepath) {}
+
+    bool isOpen() const {
+        return opened;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Open the file for appending. Does nothing if the file is already open.
+     *
+     *  @return true if the file is ready for writing
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool open() {
+        if (opened) {
+            return true;
+        }
+
+        if (!SD.begin(HardwarePins::SD_CARD)) {
+            LOG_ERROR(files, "SD card not ready, cannot open ", filepath);
+            return false;
+        }
+
+        file = SD.open(filepath, FILE_WRITE);
+        if (!file) {
+            LOG_ERROR(files, "Unable to open ", filepath);
+            return false;
+        }
+
+        opened       = true;
+        filePosition = file.size();
+        return true;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Write out whatever is left in the ring and release the file handle
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void close() {
+        if (!opened) {
+            return;
+        }
+
+        flush(true);
+        file.close();
+        opened = false;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Append a row terminated with CRLF (same as Print::println)
+     *
+     *  @param line Null terminated string
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void writeLine(const char * line) {
+        write(line, strlen(line));
+        write("\r\n", 2);
+        stats.rows++;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Copy data into the ring. Full sectors are written to the card as soon as
+     *  they are complete.
+     *
+     *  @param data Bytes to append
+     *  @param size Number of bytes
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void write(const char * data, size_t size) {
+        while (size > 0) {
+            if (count == capacity) {
+                // Ring is full so it holds at least one complete sector
+                flush(false);
+            }
+
+            size_t chunk = std::min(size, capacity - count);
+            chunk        = std::min(chunk, capacity - head);
+            memcpy(ring + head, data, chunk);
+
+            head = (head + chunk) % capacity;
+            count += chunk;
+            data += chunk;
+            size -= chunk;
+        }
+
+        flush(false);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Write complete sectors to the card.
+     *
+     *  @param force If true, also write the trailing partial sector
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void flush(bool force) {
+        if (!opened) {
+            return;
+        }
+
+        bool didWrite   = false;
+        size_t boundary = sectorSize - (filePosition % sectorSize);
+        while (count >= boundary) {
+            writeOut(boundary);
+            boundary = sectorSize;
+            didWrite = true;
+        }
+
+        if (force && count > 0) {
+            writeOut(count);
+            didWrite = true;
+        }
+
+        if (didWrite) {
+            file.flush();
+            stats.flushes++;
+        }
+    }
+
+private:
+    void writeOut(size_t size) {
+        const size_t tail  = (head + capacity - count) % capacity;
+        const size_t first = std::min(size, capacity - tail);
+        file.write(reinterpret_cast<const uint8_t *>(ring + tail), first);
+        if (size > first) {
+            file.write(reinterpret_cast<const uint8_t *>(ring), size - first);
+        }
+
+        count -= size;
+        filePosition += size;
+        stats.bytes += size;
+    }
+};
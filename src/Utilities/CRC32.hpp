@@ -0,0 +1,44 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: C R C 3 2 : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Standard CRC-32 (IEEE 802.3, same as zlib). Uses a 16-entry table, one lookup per nibble,
+// which is a good trade between flash and speed on the SAMD21. Data can be fed in pieces.
+//
+class CRC32 {
+public:
+    void update(const void * data, size_t length) {
+        static constexpr uint32_t table[16] = {
+            0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+            0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+            0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+
+        const uint8_t * bytes = static_cast<const uint8_t *>(data);
+        for (size_t i = 0; i < length; i++) {
+            crc = table[(crc ^ bytes[i]) & 0x0F] ^ (crc >> 4);
+            crc = table[(crc ^ (bytes[i] >> 4)) & 0x0F] ^ (crc >> 4);
+        }
+    }
+
+    uint32_t value() const {
+        return ~crc;
+    }
+
+    void reset() {
+        crc = 0xFFFFFFFF;
+    }
+
+    static uint32_t of(const void * data, size_t length) {
+        CRC32 crc;
+        crc.update(data, length);
+        return crc.value();
+    }
+
+private:
+    uint32_t crc = 0xFFFFFFFF;
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <Print.h>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: C H U N K E D   R E S P O N S E : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// HTTP/1.1 response body with chunked transfer encoding. The body is a Print, so ArduinoJson
+// can serialize into it piece by piece, and it goes out in chunks of at most `capacity` bytes.
+// The length of the body never has to be known up front, nor the whole body held in RAM.
+//
+//   ChunkedResponse<256> body(res.client);
+//   body.begin();
+//   serializeJson(doc, body);
+//   body.end();
+//
+template <size_t capacity>
+class ChunkedResponse : public Print {
+private:
+    Print & client;
+    uint8_t buffer[capacity];
+    size_t count = 0;
+
+public:
+    unsigned long bytes = 0;  // Body bytes sent so far, without the chunk framing
+
+    explicit ChunkedResponse(Print & client) : client(client) {}
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Send the status line and the headers. Must be called before the body.
+     *
+     *  @param contentType Value of the Content-Type header
+     *  @param extraHeaders Optional "Key: value\r\n" lines added as is
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void begin(const char * contentType = "application/json", const char * extraHeaders = "") {
+        client.print("HTTP/1.1 200 OK\r\nContent-Type: ");
+        client.print(contentType);
+        client.print("\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n");
+        client.print(extraHeaders);
+        client.print("\r\n");
+    }
+
+    size_t write(uint8_t byte) override {
+        if (count == capacity) {
+            flush();
+        }
+
+        buffer[count++] = byte;
+        return 1;
+    }
+
+    size_t write(const uint8_t * data, size_t size) override {
+        for (size_t written = 0; written < size;) {
+            if (count == capacity) {
+                flush();
+            }
+
+            const size_t n = std::min(size - written, capacity - count);
+            memcpy(buffer + count, data + written, n);
+            count += n;
+            written += n;
+        }
+
+        return size;
+    }
+
+    using Print::write;
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Send what is buffered as one chunk
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void flush() override {
+        if (count == 0) {
+            return;
+        }
+
+        char length[12];
+        snprintf(length, sizeof(length), "%X\r\n", unsigned(count));
+        client.print(length);
+        client.write(buffer, count);
+        client.print("\r\n");
+
+        bytes += count;
+        count = 0;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Send the last chunk and the terminating empty chunk
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void end() {
+        flush();
+        client.print("0\r\n\r\n");
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <Print.h>
+#include <ctype.h>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: E T A G : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Entity tag built from the boot time and the version counter of the resource, ex:
+// "5f3a1b20-1c". Version counters restart at every boot, the boot time keeps a tag cached
+// by the browser before a reboot from matching afterwards.
+// StaticAsset uses the size and CRC32 of a file instead, which hold across reboots.
+//
+class ETag {
+private:
+    char value[24];
+
+public:
+    ETag(unsigned long boot, unsigned long version) {
+        snprintf(value, sizeof(value), "\"%lx-%lx\"", boot, version);
+    }
+
+    operator const char *() const {
+        return value;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Check the If-None-Match header of a request against this tag
+     *
+     *  @param headers Raw request headers
+     *  @return true if the client already has this version
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool isMatchedBy(const char * headers) const {
+        static const char name[] = "if-none-match:";
+        for (const char * line = headers; line && *line;) {
+            size_t i = 0;
+            while (name[i] && tolower(line[i]) == name[i]) {
+                i++;
+            }
+
+            const char * end = strchr(line, '\n');
+            if (name[i] == '\0') {
+                const size_t length = end ? size_t(end - line) : strlen(line);
+                const char * found  = strstr(line + i, value);
+                return (found && found < line + length) || memchr(line + i, '*', length - i);
+            }
+
+            line = end ? end + 1 : nullptr;
+        }
+
+        return false;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Send a complete 304 response, without body
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void sendNotModified(Print & client) const {
+        client.print("HTTP/1.1 304 Not Modified\r\nETag: ");
+        client.print(value);
+        client.print("\r\nConnection: close\r\n\r\n");
+    }
+};
@@ -2,6 +2,7 @@
 #include <StreamUtils.h>
 #include <Utilities/FileLoader.hpp>
 #include <Utilities/JsonEncodableDecodable.hpp>
+#include <Utilities/Log.hpp>
 
 class JsonFileLoader : public FileLoader {
 public:
@@ -9,14 +10,13 @@ public:
     void load(const char * filepath, StaticJsonDocument<size> & dst) {
         File file = SD.open(filepath, FILE_READ);
         if (!file) {
-            KPStringBuilder<120> message("JsonFileLoader: ", filepath, " doesn't exist");
-            // println(Error(message));
+            LOG_WARN(files, filepath, " doesn't exist");
             return;
         }
 
         // skip empty file
         if (file.size() == 0) {
-            println("JsonFileLoader: ", filepath, " is empty");
+            LOG_WARN(files, filepath, " is empty");
             return;
         }
 
@@ -29,20 +29,19 @@ public:
 
         // raise error if file doesn't exist to notify the user
         if (!SD.begin(HardwarePins::SD_CARD)) {
-            println("Not ready");
+            LOG_ERROR(files, "SD card not ready");
         };
 
         File file = SD.open(filepath, FILE_READ);
         if (!file) {
-            KPStringBuilder<120> message("JsonFileLoader: ", filepath, " doesn't exist");
-            println(message);
+            LOG_WARN(files, filepath, " doesn't exist");
             file.close();
             return;
         }
 
         // skip empty file
         if (file.size() == 0) {
-            println("JsonFileLoader: ", filepath, " is empty");
+            LOG_WARN(files, filepath, " is empty");
             file.close();
             return;
         }
@@ -68,14 +67,13 @@ public:
             halt(TRACE, message);
         }
 
-        println();
-        println("Finished loading from ", filepath, " in ", millis() - start, " ms");
-        println("Json size: ", doc.memoryUsage(), " bytes");
+        LOG_DEBUG(files, "Loaded ", filepath, " in ", millis() - start, " ms, ",
+                  doc.memoryUsage(), " bytes of JSON");
         decoder.decodeJSON(doc.template as<JsonVariant>());
     }
 
     template <typename Encoder>
-    void save(const char * filepath, const Encoder & encoder) const {
+    bool save(const char * filepath, const Encoder & encoder) const {
         // call the encoder function
         StaticJsonDocument<Encoder::encodingSize()> doc;
         JsonVariant dest = doc.template to<JsonVariant>();
@@ -86,25 +84,35 @@ public:
             halt(TRACE, message);
         }
 
-        save(filepath, doc);
+        return save(filepath, doc);
     }
 
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Replace the file with the serialized document
+     *
+     *  @return bool false if the file could not be written
+     *  ──────────────────────────────────────────────────────────────────────────── */
     template <size_t size>
-    void save(const char * filepath, StaticJsonDocument<size> & src) const {
+    bool save(const char * filepath, StaticJsonDocument<size> & src) const {
         // timestamp
         unsigned long start = millis();
 
         if (!SD.begin(HardwarePins::SD_CARD)) {
-            println("Not ready");
+            LOG_ERROR(files, "SD card not ready");
         };
 
         // serialize JSON document to file
         File file = SD.open(filepath, O_RDWR | O_CREAT | O_TRUNC);
-        serializeJson(src, file);
+        if (!file) {
+            LOG_ERROR(files, "Unable to open ", filepath);
+            return false;
+        }
+
+        const size_t written = serializeJson(src, file);
         file.close();
 
-        println();
-        println("Finished writing to ", filepath, " in ", millis() - start, " ms");
-        println("Json size: ", src.memoryUsage(), " bytes");
+        LOG_DEBUG(files, "Wrote ", filepath, " in ", millis() - start, " ms, ",
+                  src.memoryUsage(), " bytes of JSON");
+        return written > 0;
     }
 };
\ No newline at end of file
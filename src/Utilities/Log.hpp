@@ -0,0 +1,82 @@
+#pragma once
+#include <KPFoundation.hpp>
+
+#include <Application/Constants.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: L O G : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Leveled serial logging with one level per module, all resolved at compile time. A
+// disabled statement is an `if` on a constant: the compiler drops it with its arguments and
+// strings, so a message can call measureJson or serializeJsonPretty at no cost when off.
+//
+//   LOG_DEBUG(sensors, "Volume: ", volume, ", LPM: ", lpm);
+//   if (LOG_ENABLED(debug, api)) {
+//       serializeJsonPretty(response, Serial);
+//   }
+//
+// LOG_LEVEL defaults to debug in DEBUG builds and to warning otherwise. Each module follows
+// it unless overridden with a build flag, ex: -D LOG_LEVEL_SENSORS=4. Levels: 0 none,
+// 1 error, 2 warning, 3 info, 4 debug.
+//
+#ifndef LOG_LEVEL
+    #ifdef DEBUG
+        #define LOG_LEVEL 4
+    #else
+        #define LOG_LEVEL 2
+    #endif
+#endif
+
+#ifndef LOG_LEVEL_APP
+    #define LOG_LEVEL_APP LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_API
+    #define LOG_LEVEL_API LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_FILES
+    #define LOG_LEVEL_FILES LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SENSORS
+    // Flow readings are logged on every pulse. Opt in with -D LOG_LEVEL_SENSORS=4
+    #define LOG_LEVEL_SENSORS (LOG_LEVEL < 3 ? LOG_LEVEL : 3)
+#endif
+#ifndef LOG_LEVEL_TASKS
+    #define LOG_LEVEL_TASKS LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_VALVES
+    #define LOG_LEVEL_VALVES LOG_LEVEL
+#endif
+
+namespace Log {
+    enum Level : uint8_t { none = 0, error, warning, info, debug };
+
+    namespace Module {
+        constexpr Level app     = Level(LOG_LEVEL_APP);
+        constexpr Level api     = Level(LOG_LEVEL_API);
+        constexpr Level files   = Level(LOG_LEVEL_FILES);
+        constexpr Level sensors = Level(LOG_LEVEL_SENSORS);
+        constexpr Level tasks   = Level(LOG_LEVEL_TASKS);
+        constexpr Level valves  = Level(LOG_LEVEL_VALVES);
+    }  // namespace Module
+
+    template <typename... Args>
+    void write(const char * prefix, const char * module, Args &&... args) {
+        println(prefix, module, ": ", std::forward<Args>(args)...);
+    }
+}  // namespace Log
+
+#define LOG_ENABLED(level, module) (Log::level <= Log::Module::module)
+
+#define LOG_AT(level, prefix, module, ...)                \
+    do {                                                  \
+        if (LOG_ENABLED(level, module)) {                 \
+            Log::write(prefix, #module, __VA_ARGS__);     \
+        }                                                 \
+    } while (0)
+
+#define LOG_ERROR(module, ...) LOG_AT(error, RED("E "), module, __VA_ARGS__)
+#define LOG_WARN(module, ...)  LOG_AT(warning, BROWN("W "), module, __VA_ARGS__)
+#define LOG_INFO(module, ...)  LOG_AT(info, "I ", module, __VA_ARGS__)
+#define LOG_DEBUG(module, ...) LOG_AT(debug, "D ", module, __VA_ARGS__)
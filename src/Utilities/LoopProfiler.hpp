@@ -0,0 +1,145 @@
+#pragma once
+#ifdef PERF_PROFILER
+    #include <KPFoundation.hpp>
+    #include <KPController.hpp>
+    #include <ArduinoJson.h>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: L O O P   P R O F I L E R : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Times every component update of the main loop. Only compiled with -D PERF_PROFILER.
+//
+// When enabled, App runs the loop through update() below instead of KPController::update.
+// Both call update() on each component in the order they were added, so the loop behaves the
+// same; the profiler just wraps each call with micros().
+//
+template <size_t capacity>
+class LoopProfiler {
+public:
+    // Upper bound (exclusive) of each histogram bucket in micros. The last bucket is open.
+    static constexpr unsigned long bucketLimits[] = {100, 1000, 10000, 100000};
+    static constexpr size_t numberOfBuckets
+        = sizeof(bucketLimits) / sizeof(bucketLimits[0]) + 1;
+
+    struct Entry {
+        KPComponent * component = nullptr;
+        unsigned long min       = 0;
+        unsigned long max       = 0;
+        unsigned long count     = 0;
+        uint64_t total          = 0;
+        unsigned long histogram[numberOfBuckets]{};
+
+        void record(unsigned long elapsed) {
+            min = count ? std::min(min, elapsed) : elapsed;
+            max = std::max(max, elapsed);
+            total += elapsed;
+            count++;
+
+            size_t bucket = 0;
+            while (bucket < numberOfBuckets - 1 && elapsed >= bucketLimits[bucket]) {
+                bucket++;
+            }
+
+            histogram[bucket]++;
+        }
+
+        unsigned long mean() const {
+            return count ? total / count : 0;
+        }
+    };
+
+private:
+    Entry entries[capacity];
+    size_t size = 0;
+    Entry loop;  // whole loop iteration, component is null
+
+public:
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Add a component to the profiled loop. Halts if the profiler is full, see
+     *  ProgramSettings::PROFILED_COMPONENTS.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void track(KPComponent & component) {
+        if (size == capacity) {
+            halt(TRACE, "LoopProfiler is full. Increase its capacity");
+        }
+
+        entries[size++].component = &component;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Run one loop iteration: update every tracked component and record how
+     *  long each one took.
+     *
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void update() {
+        const unsigned long loopStart = micros();
+        for (size_t i = 0; i < size; i++) {
+            const unsigned long start = micros();
+            entries[i].component->update();
+            entries[i].record(micros() - start);
+        }
+
+        loop.record(micros() - loopStart);
+    }
+
+    void reset() {
+        for (size_t i = 0; i < size; i++) {
+            entries[i] = Entry{entries[i].component};
+        }
+
+        loop = Entry{};
+    }
+
+    void print() const {
+        println("component, count, min, mean, max (us), "
+                "histogram <100us <1ms <10ms <100ms >=100ms");
+        printEntry("loop", loop);
+        for (size_t i = 0; i < size; i++) {
+            printEntry(entries[i].component->name, entries[i]);
+        }
+    }
+
+    static constexpr size_t encodingSize() {
+        return JSON_ARRAY_SIZE(capacity + 1)
+               + (capacity + 1) * (JSON_OBJECT_SIZE(6) + JSON_ARRAY_SIZE(numberOfBuckets));
+    }
+
+    bool encodeJSON(const JsonVariant & dest) const {
+        bool success = encodeEntry("loop", loop, dest.createNestedObject());
+        for (size_t i = 0; i < size; i++) {
+            success = success
+                      && encodeEntry(entries[i].component->name, entries[i],
+                                     dest.createNestedObject());
+        }
+
+        return success;
+    }
+
+private:
+    static void printEntry(const char * name, const Entry & entry) {
+        ::print(name, ", ", entry.count, ", ", entry.min, ", ", entry.mean(), ", ", entry.max);
+        for (auto n : entry.histogram) {
+            ::print(", ", n);
+        }
+
+        println();
+    }
+
+    static bool encodeEntry(const char * name, const Entry & entry, const JsonObject & dest) {
+        JsonArray histogram = dest.createNestedArray("histogram");
+        for (auto n : entry.histogram) {
+            histogram.add(n);
+        }
+
+        return dest["name"].set(name) && dest["count"].set(entry.count)
+               && dest["min"].set(entry.min) && dest["mean"].set(entry.mean())
+               && dest["max"].set(entry.max);
+    }
+};
+
+template <size_t capacity>
+constexpr unsigned long LoopProfiler<capacity>::bucketLimits[];
+#endif
@@ -0,0 +1,127 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <Print.h>
+#include <SD.h>
+
+#include <Application/Constants.hpp>
+#include <Utilities/CRC32.hpp>
+#include <Utilities/ETag.hpp>
+#include <Utilities/Log.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S T A T I C   A S S E T : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Pre-compressed file served from the SD card, ex: the web UI bundle index.gz. The file is
+// read once by load() to get its size and CRC32, which make its ETag. Browsers then revalidate
+// with If-None-Match and get a 304 instead of the whole file. The tag only depends on the
+// content, so it stays valid across reboots until the file is replaced.
+//
+class StaticAsset {
+private:
+    const char * path;
+    const char * encoding;
+    uint32_t size = 0;
+    uint32_t crc  = 0;
+    bool loaded   = false;
+
+    // Shared by every asset, files are read one at a time
+    static uint8_t * buffer() {
+        static uint8_t data[ProgramSettings::STATIC_ASSET_BUFFER_SIZE];
+        return data;
+    }
+
+public:
+    StaticAsset(const char * path, const char * encoding) : path(path), encoding(encoding) {}
+
+    bool isLoaded() const {
+        return loaded;
+    }
+
+    ETag etag() const {
+        return ETag(size, crc);
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Read the whole file to compute its size and CRC32
+     *
+     *  @return true if the file exists and was read
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool load() {
+        File file = SD.open(path, FILE_READ);
+        loaded    = false;
+        if (!file) {
+            LOG_WARN(files, "Missing static asset ", path);
+            return false;
+        }
+
+        digest(file);
+        file.close();
+        return true;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Send the file as a complete response, or a 304 if the request holds
+     *  its current ETag. A file added or replaced by one of another size since load()
+     *  is read again first so that the tag and Content-Length describe what is sent.
+     *
+     *  @param client Connection of the request
+     *  @param headers Raw request headers
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void send(Print & client, const char * headers) {
+        File file = SD.open(path, FILE_READ);
+        if (!file) {
+            LOG_ERROR(files, "Cannot open static asset ", path);
+            client.print("HTTP/1.1 404 Not Found\r\nConnection: close\r\n\r\n");
+            return;
+        }
+
+        if (!loaded || file.size() != size) {
+            digest(file);
+            file.seek(0);
+        }
+
+        const ETag tag = etag();
+        if (tag.isMatchedBy(headers)) {
+            file.close();
+            tag.sendNotModified(client);
+            return;
+        }
+
+        char length[12];
+        snprintf(length, sizeof(length), "%lu", (unsigned long) size);
+        client.print("HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Encoding: ");
+        client.print(encoding);
+        client.print("\r\nContent-Length: ");
+        client.print(length);
+        client.print("\r\nETag: ");
+        client.print(tag);
+        client.print("\r\nCache-Control: ");
+        client.print(ProgramSettings::STATIC_ASSET_CACHE_CONTROL);
+        client.print("\r\nVary: Accept-Encoding\r\nConnection: close\r\n\r\n");
+
+        for (int n; (n = file.read(buffer(), ProgramSettings::STATIC_ASSET_BUFFER_SIZE)) > 0;) {
+            client.write(buffer(), n);
+        }
+
+        file.close();
+    }
+
+private:
+    void digest(File & file) {
+        const unsigned long start = millis();
+
+        CRC32 checksum;
+        size = 0;
+        for (int n; (n = file.read(buffer(), ProgramSettings::STATIC_ASSET_BUFFER_SIZE)) > 0;) {
+            checksum.update(buffer(), n);
+            size += n;
+        }
+
+        crc    = checksum.value();
+        loaded = true;
+        LOG_INFO(files, path, ": ", size, " bytes, ETag ", (const char *) etag(), " in ",
+                 millis() - start, " ms");
+    }
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <KPFoundation.hpp>
+#include <SD.h>
+
+#include <Application/Constants.hpp>
+#include <Utilities/Log.hpp>
+
+//
+// ──────────────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S T O R E   G E N E R A T I O N : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────────────
+//
+// Counter kept in a 4-byte file on the SD card, bumped before the valve and task files are
+// written. The boot snapshot records it so that a snapshot taken before any of these writes
+// is known to be stale without reading the files themselves.
+//
+// Only the first write after boot or after mark() touches the card: later writes would bump
+// a counter that nothing has recorded yet.
+//
+class StoreGeneration {
+private:
+    struct State {
+        uint32_t value = 0;
+        bool loaded    = false;
+        bool bumped    = false;
+    };
+
+    static State & state() {
+        static State instance;
+        return instance;
+    }
+
+public:
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Current generation, read from the SD card on first use. 0 if missing.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static uint32_t current() {
+        State & s = state();
+        if (!s.loaded) {
+            File file = SD.open(ProgramSettings::STORE_GENERATION_FILE, FILE_READ);
+            if (!file || file.read(&s.value, sizeof(s.value)) != int(sizeof(s.value))) {
+                s.value = 0;
+            }
+
+            if (file) {
+                file.close();
+            }
+
+            s.loaded = true;
+        }
+
+        return s.value;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Call before writing a valve or task file. Retried by the next call if the
+     *  counter could not be written.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static void bump() {
+        State & s = state();
+        if (s.bumped) {
+            return;
+        }
+
+        const uint32_t next = current() + 1;
+        File file = SD.open(ProgramSettings::STORE_GENERATION_FILE, O_RDWR | O_CREAT | O_TRUNC);
+        if (!file) {
+            LOG_ERROR(files, "Unable to open ", ProgramSettings::STORE_GENERATION_FILE);
+            return;
+        }
+
+        s.bumped = file.write(reinterpret_cast<const uint8_t *>(&next), sizeof(next))
+                   == sizeof(next);
+        file.close();
+        if (s.bumped) {
+            s.value = next;
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief The current generation was recorded. The next write bumps it again.
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static void mark() {
+        state().bumped = false;
+    }
+};
@@ -6,7 +6,10 @@
 #include <Valve/ValveStatus.hpp>
 #include <Valve/ValveObserver.hpp>
 #include <Utilities/FileLoader.hpp>
+#include <Utilities/Log.hpp>
+#include <Utilities/StoreGeneration.hpp>
 
+#include <bitset>
 #include <vector>
 
 //
@@ -21,6 +24,39 @@ public:
     const char * valveFolder   = nullptr;
     size_t numberOfValvesInUse = 0;
 
+    // Also store all valves in a single binary file, read at boot instead of one JSON file
+    // per valve. The JSON files are still written and serve as fallback.
+    bool usePackedTable = false;
+
+    // Persisted state of one valve. Also used by the boot snapshot.
+    struct TableRecord {
+        int8_t status;
+        char group[ProgramSettings::VALVE_GROUP_LENGTH];
+    } __attribute__((packed));
+
+private:
+    // Valves that changed since they were last written to the SD card
+    std::bitset<ProgramSettings::MAX_VALVES> dirty;
+
+    // Incremented by every change to the valves, exposed as the ETag of /api/valves
+    unsigned long changes = 0;
+
+    // ─── PACKED TABLE FORMAT ─────────────────────────────────────────────
+    // Header followed by one fixed-size record per valve so that a single valve can be
+    // rewritten in place by seeking to its record.
+    struct TableHeader {
+        uint32_t magic;
+        uint8_t version;
+        uint8_t count;
+        uint8_t recordSize;
+        uint8_t reserved;
+    } __attribute__((packed));
+
+    static constexpr uint32_t tableMagic  = 0x4C425456;  // "VTBL"
+    static constexpr uint8_t tableVersion = 1;
+
+public:
+
     /** ────────────────────────────────────────────────────────────────────────────
      *  Initialize ValveManager with the config object. This method sets
      *  status for each valve according to config object.
@@ -28,8 +64,10 @@ public:
      *  @param config onfig object containing meta information about the system
      *  ──────────────────────────────────────────────────────────────────────────── */
     void init(Config & config) {
-        valveFolder = config.valveFolder;
+        valveFolder    = config.valveFolder;
+        usePackedTable = config.packedValveTable;
         valves.resize(config.numberOfValves);
+        dirty.reset();
 
         for (size_t i = 0; i < valves.size(); i++) {
             auto valveAvailability = config.valves[i];
@@ -41,17 +79,55 @@ public:
                 numberOfValvesInUse++;
             }
 
-            println(status);
+            LOG_DEBUG(valves, "Valve ", i, ": ", status);
         }
 
+        changes++;
         updateObservers(&ValveObserver::valveArrayDidUpdate, valves);
     }
 
+    unsigned long version() const {
+        return changes;
+    }
+
     void setValveStatus(int id, ValveStatus status) {
         valves[id].setStatus(status);
+        dirty.set(id);
+        changes++;
         updateObservers(&ValveObserver::valveDidUpdate, valves[id]);
     }
 
+    bool isDirty(int id) const {
+        return dirty.test(id);
+    }
+
+    static TableRecord toRecord(const Valve & valve) {
+        TableRecord record;
+        record.status = valve.status;
+        strncpy(record.group, valve.group, ProgramSettings::VALVE_GROUP_LENGTH);
+        return record;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Restore every valve from records already in memory. Valves that the config
+     *  marks as unavailable keep that status.
+     *
+     *  @param records One record per valve
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    void restoreRecords(const TableRecord * records) {
+        for (size_t i = 0; i < valves.size(); i++) {
+            if (valves[i].status != ValveStatus::unavailable) {
+                valves[i].status = records[i].status;
+                strncpy(valves[i].group, records[i].group, ProgramSettings::VALVE_GROUP_LENGTH);
+                valves[i].group[ProgramSettings::VALVE_GROUP_LENGTH - 1] = 0;
+            }
+        }
+
+        dirty.reset();
+        changes++;
+        updateObservers(&ValveObserver::valveArrayDidUpdate, valves);
+    }
+
     /** ────────────────────────────────────────────────────────────────────────────
      *  @brief Set the status of the valve to "free" if the valve is not yet sampled
      *
@@ -74,17 +150,20 @@ public:
             int id = object[ValveKeys::ID];
             if (valves[id].status != ValveStatus::sampled) {
                 valves[id].decodeJSON(object);
+                dirty.set(id);
             } else {
-                println("Valve is already sampled");
+                LOG_WARN(valves, "Valve ", id, " is already sampled");
             }
         }
 
+        changes++;
         updateObservers(&ValveObserver::valveArrayDidUpdate, valves);
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
      *  @brief Reading and decode each JSON file in the given directory to
-     *  corresponding valve object.
+     *  corresponding valve object. When the packed table is enabled, the table is read
+     *  instead and the JSON files are only used if the table is missing or invalid.
      *
      *  @param _dir Path to the valve folder (default=~/valves)
      *  ──────────────────────────────────────────────────────────────────────────── */
@@ -95,43 +174,178 @@ public:
         loader.createDirectoryIfNeeded(dir);
 
         auto start = millis();
+        if (usePackedTable && loadTable(dir)) {
+            println(GREEN("Valve Manager"), " finished reading table in ", millis() - start,
+                    " ms\n");
+            return;
+        }
+
         for (size_t i = 0; i < valves.size(); i++) {
             if (valves[i].status != ValveStatus::unavailable) {
                 KPStringBuilder<32> filename("valve-", i, ".js");
                 KPStringBuilder<64> filepath(dir, "/", filename);
+                if (!SD.exists(filepath)) {
+                    // Nothing on the card yet, make sure the next save creates it
+                    dirty.set(i);
+                    continue;
+                }
+
                 loader.load(filepath, valves[i]);
             }
         }
 
+        if (usePackedTable) {
+            // Table is missing or invalid. Rebuild it from the JSON files on next save
+            dirty.set();
+        }
+
         println(GREEN("Valve Manager"), " finished reading in ", millis() - start, " ms\n");
+        changes++;
         updateObservers(&ValveObserver::valveArrayDidUpdate, valves);
     }
 
     /** ────────────────────────────────────────────────────────────────────────────
-     *  @brief Encode and store each valve object to corresponding JSON file in the
-     *  given directory
+     *  @brief Encode and store each modified valve object to corresponding JSON file
+     *  in the given directory, and to its record in the packed table if enabled
      *
      *  @param _dir Path to the valve folder (default=~/valves)
      *  ──────────────────────────────────────────────────────────────────────────── */
     void writeToDirectory(const char * _dir = nullptr) {
         const char * dir = _dir ? _dir : valveFolder;
+        if (dirty.any()) {
+            StoreGeneration::bump();
+        }
 
         JsonFileLoader loader;
         loader.createDirectoryIfNeeded(dir);
 
-        auto start = millis();
+        auto start    = millis();
+        size_t writes = 0;
+        bool success  = true;
         for (size_t i = 0; i < valves.size(); i++) {
-            if (valves[i].status != ValveStatus::unavailable) {
+            if (dirty.test(i) && valves[i].status != ValveStatus::unavailable) {
                 KPStringBuilder<32> filename("valve-", i, ".js");
                 KPStringBuilder<64> filepath(dir, "/", filename);
-                loader.save(filepath, valves[i]);
+                success = loader.save(filepath, valves[i]) && success;
+                writes++;
             }
         }
 
-        println("\033[1;32mValveManager\033[0m: finished writing in ", millis() - start, " ms");
+        if (usePackedTable && dirty.any()) {
+            success = writeTable(dir) && success;
+        }
+
+        // Retried on the next save otherwise
+        if (success) {
+            dirty.reset();
+        }
+
+        LOG_DEBUG(valves, "Finished writing ", writes, " valves in ", millis() - start, " ms");
         updateObservers(&ValveObserver::valveArrayDidUpdate, valves);
     }
 
+private:
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Read every valve from the packed table with one sequential read
+     *
+     *  @param dir Path to the valve folder
+     *  @return true if the table exists and matches the current valve configuration
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool loadTable(const char * dir) {
+        KPStringBuilder<64> filepath(dir, "/", ProgramSettings::VALVE_TABLE_FILE);
+        File file = SD.open(filepath, FILE_READ);
+        if (!file) {
+            return false;
+        }
+
+        TableRecord records[ProgramSettings::MAX_VALVES];
+        bool valid = hasValidHeader(file);
+        if (valid) {
+            const int size = sizeof(TableRecord) * valves.size();
+            valid          = file.read(records, size) == size;
+        }
+
+        file.close();
+        if (!valid) {
+            LOG_ERROR(valves, "Invalid table ", filepath);
+            return false;
+        }
+
+        // Availability comes from the config file
+        restoreRecords(records);
+        return true;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Read the header at the current position and check it against the
+     *  current valve configuration and the size of the file
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool hasValidHeader(File & file) const {
+        TableHeader header;
+        return file.read(&header, sizeof(header)) == sizeof(header) && header.magic == tableMagic
+               && header.version == tableVersion && header.recordSize == sizeof(TableRecord)
+               && header.count == valves.size()
+               && file.size() == sizeof(TableHeader) + sizeof(TableRecord) * valves.size();
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Rewrite the records of dirty valves in place. The whole table is written
+     *  in one go if it doesn't exist yet or doesn't match the valve configuration.
+     *
+     *  @param dir Path to the valve folder
+     *  @return bool true if the table is up to date
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool writeTable(const char * dir) {
+        if (!SD.begin(HardwarePins::SD_CARD)) {
+            LOG_ERROR(files, "SD card not ready, valves not written");
+            return false;
+        }
+
+        KPStringBuilder<64> filepath(dir, "/", ProgramSettings::VALVE_TABLE_FILE);
+        File file         = SD.open(filepath, O_RDWR);
+        const bool update = file && hasValidHeader(file);
+        if (!update) {
+            if (file) {
+                file.close();
+            }
+
+            file = SD.open(filepath, O_RDWR | O_CREAT | O_TRUNC);
+        }
+
+        if (!file) {
+            LOG_ERROR(valves, "Unable to open ", filepath);
+            return false;
+        }
+
+        if (update) {
+            for (size_t i = 0; i < valves.size(); i++) {
+                if (!dirty.test(i)) {
+                    continue;
+                }
+
+                TableRecord record = toRecord(valves[i]);
+                file.seek(sizeof(TableHeader) + sizeof(TableRecord) * i);
+                file.write(reinterpret_cast<const uint8_t *>(&record), sizeof(record));
+            }
+        } else {
+            TableHeader header{tableMagic, tableVersion, static_cast<uint8_t>(valves.size()),
+                               sizeof(TableRecord), 0};
+            TableRecord records[ProgramSettings::MAX_VALVES];
+            for (size_t i = 0; i < valves.size(); i++) {
+                records[i] = toRecord(valves[i]);
+            }
+
+            file.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+            file.write(reinterpret_cast<const uint8_t *>(records),
+                       sizeof(TableRecord) * valves.size());
+        }
+
+        file.close();
+        return true;
+    }
+
+public:
+
 #pragma region JSONENCODABLE
     static const char * encoderName() {
         return "ValveManager";
@@ -0,0 +1,335 @@
+#include <Application/App.hpp>
+#include <DS3232RTC.h>
+#include <NativeHAL.hpp>
+#include <SD.h>
+#include <MS5803_02.h>
+#include <Devices/SamplerBoard.hpp>
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: A P P   B E N C H M A R K : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Runs the full App on the host against lib/NativeHAL and prints the wall clock cost of the
+// hot paths. Use `pio test -e native`. Set NATIVE_VERBOSE=1 to see the firmware output and
+// NATIVE_SD_TEMPLATE to start from another SD card image (default: sdcard_template).
+//
+// The numbers are host numbers: compare them between commits, not against the SAMD21.
+//
+
+namespace {
+    App app;
+
+    NativeHAL::SamplerBoard board;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Sample {
+        double total = 0;
+        double max   = 0;
+        long count   = 0;
+
+        void add(Clock::duration duration) {
+            const double us = std::chrono::duration<double, std::micro>(duration).count();
+            total += us;
+            max = std::max(max, us);
+            count++;
+        }
+
+        void print(const char * name) const {
+            printf("%-32s n=%-6ld mean=%10.2f us  max=%10.2f us\n", name, count,
+                   count ? total / count : 0, max);
+        }
+    };
+
+    template <typename F>
+    Sample measure(long iterations, F && body) {
+        Sample sample;
+        for (long i = 0; i < iterations; i++) {
+            const auto start = Clock::now();
+            body();
+            sample.add(Clock::now() - start);
+        }
+
+        return sample;
+    }
+
+    // Invert one byte of a file on the SD card. The size stays the same and a second call
+    // restores the file.
+    void flipByte(const char * filepath, long offset) {
+        FILE * file = fopen(NativeHAL::sdPath(filepath).c_str(), "r+b");
+        TEST_ASSERT_NOT_NULL(file);
+        fseek(file, offset, SEEK_SET);
+        const int byte = fgetc(file);
+        fseek(file, offset, SEEK_SET);
+        fputc(byte ^ 0xFF, file);
+        fclose(file);
+    }
+
+    bool loadSnapshot() {
+        BootSnapshot snapshot;
+        return snapshot.load(app.config.configFilepath);
+    }
+
+    void printSDStats(const char * name) {
+        auto & stats = NativeHAL::sdStats();
+        printf("%-32s opens=%lu read=%lu B written=%lu B flushes=%lu\n", name, stats.opens,
+               stats.bytesRead, stats.bytesWritten, stats.flushes);
+        stats = NativeHAL::SDStats{};
+    }
+}  // namespace
+
+// ─── TESTS ───────────────────────────────────────────────────────────────────
+
+void test_setup() {
+    const auto start = Clock::now();
+    app.setup();
+    Sample sample;
+    sample.add(Clock::now() - start);
+    sample.print("App::setup");
+    printSDStats("App::setup SD");
+
+    // Config comes from the SD card; an empty log file name means it was never loaded
+    TEST_ASSERT_TRUE(app.config.logFile[0] != 0);
+}
+
+void test_update_latency() {
+    // Each iteration moves the virtual clock by 1 ms so that timed actions and sensor polling
+    // behave as they would on the board
+    auto sample = measure(20000, []() {
+        app.update();
+        NativeHAL::advance(1);
+    });
+
+    sample.print("App::update (idle)");
+    TEST_ASSERT_EQUAL(20000, sample.count);
+}
+
+void test_schedule_next_active_task() {
+    const int numberOfTasks = 50;
+    const time_t start      = now();
+    for (int i = 0; i < numberOfTasks; i++) {
+        Task task = app.tm.createTask();
+        snprintf(task.name, sizeof(task.name), "bench-%d", i);
+        task.schedule    = start + 3600 + i * 60;
+        task.timeBetween = 5;
+        task.valves.push_back(i % ProgramSettings::MAX_VALVES);
+        app.tm.insertTask(task, true);
+        app.tm.setTaskStatus(task.id, TaskStatus::active);
+    }
+
+    auto sample = measure(1000, []() { app.scheduleNextActiveTask(); });
+    sample.print("scheduleNextActiveTask (50)");
+    TEST_ASSERT_EQUAL(numberOfTasks, app.tm.getActiveSortedTaskIds().size());
+}
+
+void test_persistence() {
+    NativeHAL::sdStats() = NativeHAL::SDStats{};
+
+    measure(1, []() { app.tm.writeChangesToJournal(); }).print("TaskManager journal");
+    printSDStats("TaskManager journal SD");
+
+    measure(1, []() { app.vm.writeToDirectory(); }).print("ValveManager write");
+    printSDStats("ValveManager write SD");
+
+    const auto numberOfTasks = app.tm.taskCollection().size();
+    measure(1, []() { app.tm.loadTasksFromDirectory(); }).print("TaskManager load + compact");
+    printSDStats("TaskManager load SD");
+
+    TEST_ASSERT_EQUAL(numberOfTasks, app.tm.taskCollection().size());
+}
+
+void test_journal_torn_entry() {
+    // Power loss tore the first append after the compaction of test_persistence
+    using ProgramSettings::TASK_JOURNAL_FILE;
+    KPStringBuilder<32> journalPath(app.config.taskFolder, "/", TASK_JOURNAL_FILE);
+    File journal = SD.open(journalPath, FILE_WRITE);
+    journal.print("{\"op\":\"status\",\"id\":");
+    journal.close();
+
+    // Changes of the following boots land behind it
+    const int removed = app.tm.taskCollection().begin()->first;
+    app.tm.deleteTask(removed);
+    Task task = app.tm.createTask();
+    strcpy(task.name, "after-torn");
+    app.tm.insertTask(task, true);
+    app.tm.writeChangesToJournal();
+
+    TaskManager reloaded;
+    reloaded.init(app.config);
+    reloaded.loadTasksFromDirectory();
+    TEST_ASSERT_EQUAL(app.tm.taskCollection().size(), reloaded.taskCollection().size());
+    TEST_ASSERT_FALSE(reloaded.findTask(removed));
+    TEST_ASSERT_TRUE(reloaded.findTask(task.id));
+    TEST_ASSERT_EQUAL_STRING("after-torn", reloaded.tasks[task.id].name);
+
+    // Compacted, the torn entry went away with the journal
+    TEST_ASSERT_FALSE(SD.exists(journalPath));
+}
+
+void test_boot_snapshot() {
+    // Fields left at their defaults by the other tests
+    Task & edited = app.tm.tasks.begin()->second;
+    strcpy(edited.name, "snapshot");
+    edited.repeat.rule  = Recurrence::daily;
+    edited.repeat.at    = 390;
+    edited.repeat.count = 7;
+    edited.repeat.done  = 2;
+    edited.pipeline     = Pipeline::Sequence{};
+    edited.pipeline.add(Pipeline::Stage::flush, 20);
+    edited.pipeline.add(Pipeline::Stage::sample);
+    app.vm.setValveStatus(1, ValveStatus::sampled);
+    strcpy(app.vm.valves[1].group, "river");
+
+    // Round trip into fresh objects, consumed by the load
+    TEST_ASSERT_TRUE(BootSnapshot::save(app.config, app.vm, app.tm));
+    {
+        BootSnapshot snapshot;
+        TEST_ASSERT_TRUE(snapshot.load(app.config.configFilepath));
+
+        Config config(app.config.configFilepath);
+        snapshot.restore(config);
+        TEST_ASSERT_EQUAL(app.config.numberOfValves, config.numberOfValves);
+        TEST_ASSERT_EQUAL_INT8_ARRAY(app.config.valves, config.valves, config.numberOfValves);
+        TEST_ASSERT_EQUAL_STRING(app.config.taskFolder, config.taskFolder);
+        TEST_ASSERT_EQUAL_STRING(app.config.valveFolder, config.valveFolder);
+
+        ValveManager vm;
+        vm.init(config);
+        snapshot.restore(vm);
+        TEST_ASSERT_EQUAL(app.vm.valves.size(), vm.valves.size());
+        for (size_t i = 0; i < vm.valves.size(); i++) {
+            TEST_ASSERT_EQUAL(app.vm.valves[i].status, vm.valves[i].status);
+            TEST_ASSERT_EQUAL_STRING(app.vm.valves[i].group, vm.valves[i].group);
+        }
+
+        TaskManager tm;
+        snapshot.restore(tm);
+        TEST_ASSERT_EQUAL(app.tm.taskCollection().size(), tm.taskCollection().size());
+        for (const auto & kv : app.tm.taskCollection()) {
+            TEST_ASSERT_TRUE(tm.findTask(kv.first));
+            const Task & expected = kv.second;
+            const Task & actual   = tm.tasks[kv.first];
+            TEST_ASSERT_EQUAL_STRING(expected.name, actual.name);
+            TEST_ASSERT_EQUAL(expected.schedule, actual.schedule);
+            TEST_ASSERT_EQUAL(expected.status, actual.status);
+            TEST_ASSERT_EQUAL(expected.timeBetween, actual.timeBetween);
+            TEST_ASSERT_EQUAL(expected.valves.size(), actual.valves.size());
+            TEST_ASSERT_TRUE(expected.valves == actual.valves);
+            TEST_ASSERT_EQUAL(expected.valveOffsetStart, actual.valveOffsetStart);
+            TEST_ASSERT_EQUAL(expected.repeat.rule, actual.repeat.rule);
+            TEST_ASSERT_EQUAL(expected.repeat.every, actual.repeat.every);
+            TEST_ASSERT_EQUAL(expected.repeat.at, actual.repeat.at);
+            TEST_ASSERT_EQUAL(expected.repeat.count, actual.repeat.count);
+            TEST_ASSERT_EQUAL(expected.repeat.done, actual.repeat.done);
+            TEST_ASSERT_EQUAL(expected.pipeline.size, actual.pipeline.size);
+            for (size_t i = 0; i < expected.pipeline.size; i++) {
+                const auto & step = expected.pipeline.steps[i];
+                TEST_ASSERT_TRUE(step.stage == actual.pipeline.steps[i].stage);
+                TEST_ASSERT_EQUAL(step.time, actual.pipeline.steps[i].time);
+            }
+        }
+
+        TEST_ASSERT_EQUAL_STRING("snapshot", tm.tasks[edited.id].name);
+        TEST_ASSERT_EQUAL(2, tm.tasks[edited.id].pipeline.size);
+        TEST_ASSERT_EQUAL(ValveStatus::sampled, vm.valves[1].status);
+    }
+
+    TEST_ASSERT_FALSE(SD.exists(ProgramSettings::BOOT_SNAPSHOT_FILE));
+    TEST_ASSERT_FALSE(loadSnapshot());
+
+    // Stale: config.js edited without changing its size
+    TEST_ASSERT_TRUE(BootSnapshot::save(app.config, app.vm, app.tm));
+    flipByte(app.config.configFilepath, 1);
+    TEST_ASSERT_FALSE(loadSnapshot());
+    flipByte(app.config.configFilepath, 1);
+
+    // Stale: a valve written after the snapshot, ex: a reset before the next shutdown while
+    // the snapshot could not be removed
+    TEST_ASSERT_TRUE(BootSnapshot::save(app.config, app.vm, app.tm));
+    app.vm.setValveStatus(0, ValveStatus::Code(app.vm.valves[0].status));
+    app.vm.writeToDirectory();
+    TEST_ASSERT_FALSE(loadSnapshot());
+
+    // Stale: a task journaled after the snapshot
+    TEST_ASSERT_TRUE(BootSnapshot::save(app.config, app.vm, app.tm));
+    const int id = app.tm.taskCollection().begin()->first;
+    app.tm.setTaskStatus(id, TaskStatus::Code(app.tm.tasks[id].status));
+    app.tm.writeChangesToJournal();
+    TEST_ASSERT_FALSE(loadSnapshot());
+
+    // Up to date again once saved. Loading opens boot.bin, config.js and at most gen.bin,
+    // never the valve or task files.
+    TEST_ASSERT_TRUE(BootSnapshot::save(app.config, app.vm, app.tm));
+    NativeHAL::sdStats() = NativeHAL::SDStats{};
+    TEST_ASSERT_TRUE(loadSnapshot());
+    TEST_ASSERT_TRUE(NativeHAL::sdStats().opens <= 3);
+    printSDStats("BootSnapshot load SD");
+
+    // Corrupted record
+    TEST_ASSERT_TRUE(BootSnapshot::save(app.config, app.vm, app.tm));
+    flipByte(ProgramSettings::BOOT_SNAPSHOT_FILE, sizeof(BootSnapshot::Header) + 1);
+    TEST_ASSERT_FALSE(loadSnapshot());
+}
+
+void test_baro_conversion() {
+    // Time the loop is held per reading, in virtual micros: delay() in the blocking path
+    // advances the clock, poll() never does. The host cost of the I2C calls is printed next
+    // to it. Polls happen once per simulated 1 ms loop.
+    MS_5803 sensor(0x77, ProgramSettings::BARO_IDLE_RESOLUTION);
+    sensor.initializeMS_5803(false);
+
+    for (uint16_t resolution : {256, 4096}) {
+        sensor.setResolution(resolution);
+        char name[48];
+
+        uint64_t blocked = 0;
+        auto blocking    = measure(100, [&]() {
+            const uint64_t start = NativeHAL::elapsedMicros();
+            sensor.readSensor();
+            blocked += NativeHAL::elapsedMicros() - start;
+        });
+
+        snprintf(name, sizeof(name), "MS5803 readSensor (%u)", resolution);
+        blocking.print(name);
+        printf("%-32s %.2f us blocked per reading\n", "", blocked / 100.0);
+
+        const auto baro1Conversions = board.baro1.conversions;
+        long polls                  = 0;
+        Sample async;
+        for (int readings = 0; readings < 100; polls++) {
+            const auto start = Clock::now();
+            readings += sensor.poll();
+            async.add(Clock::now() - start);
+            NativeHAL::advance(1);
+        }
+
+        snprintf(name, sizeof(name), "MS5803 poll (%u)", resolution);
+        async.print(name);
+        printf("%-32s %.2f polls per reading\n", "", polls / 100.0);
+
+        TEST_ASSERT_EQUAL(200, board.baro1.conversions - baro1Conversions);
+        TEST_ASSERT_FLOAT_WITHIN(1, board.baro1.pressure, sensor.pressure());
+    }
+}
+
+int main(int argc, char ** argv) {
+    const char * sdTemplate = getenv("NATIVE_SD_TEMPLATE");
+    board.begin(HardwarePins::RTC_INTERRUPT, sdTemplate ? sdTemplate : "sdcard_template");
+    board.pressureSensor.pressure = 12.5;
+
+    UNITY_BEGIN();
+    RUN_TEST(test_setup);
+    RUN_TEST(test_update_latency);
+    RUN_TEST(test_schedule_next_active_task);
+    RUN_TEST(test_persistence);
+    RUN_TEST(test_journal_torn_entry);
+    RUN_TEST(test_boot_snapshot);
+    RUN_TEST(test_baro_conversion);
+    return UNITY_END();
+}
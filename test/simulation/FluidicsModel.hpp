@@ -0,0 +1,183 @@
+#pragma once
+#include <NativeHAL.hpp>
+#include <Devices/SSCDevice.hpp>
+
+#include <Application/Constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: F L U I D I C S   M O D E L : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Physical side of the sampler for host simulations. The model watches the pump pins and the
+// shift register outputs, and on every clock step:
+//
+//   - moves the ball intake (full travel takes intakeTravelSeconds)
+//   - computes the water flow through the open path and the pressure at the filter housing,
+//     which rises with the volume already pushed through that filter
+//   - generates turbine pulses on ANALOG_SENSOR_1 (falling edges, same as the sensor)
+//   - feeds the pressure to the simulated SSC sensor
+//
+// Pulses fire at exact times as long as the caller steps the clock to nextEventMicros().
+// Pulses that fall inside a longer step (ex: delay() in the firmware) collapse into a single
+// pulse at the end of the step.
+//
+class FluidicsModel {
+public:
+    struct Parameters {
+        float intakeTravelSeconds = 5;
+        float sampleLpm           = 1.0;  // flow through a clean filter
+        float flushLpm            = 1.5;  // flow through the flush valve
+        float basePressure        = 2;    // psi at the filter housing with a clean filter
+        float flushPressure       = 1;    // psi when flushing
+        float clogPsiPerLiter     = 4;    // pressure rise per liter through a filter
+        float pumpMaxPressure     = 25;   // psi at which the pump stalls
+    };
+
+    // Ground truth, as opposed to what the firmware measured
+    struct Totals {
+        double waterLiters   = 0;
+        unsigned long pulses = 0;
+    };
+
+    Parameters parameters;
+    Totals totals;
+    std::vector<double> filteredLiters = std::vector<double>(ProgramSettings::MAX_VALVES, 0);
+
+    float intakePosition = 0;  // 0 closed, 1 fully open
+    float lpm            = 0;
+    float pressure       = 0;
+
+private:
+    NativeHAL::SSCDevice & pressureSensor;
+    int listener            = -1;
+    uint64_t nextPulse      = 0;
+    double pulsePhase       = 0;  // fraction of a turbine period since the last pulse
+    const uint32_t pin      = HardwarePins::ANALOG_SENSOR_1;
+    const int firstValvePin = 8;  // the first register drives the TPIC devices
+
+public:
+    FluidicsModel(NativeHAL::SSCDevice & pressureSensor) : pressureSensor(pressureSensor) {}
+
+    ~FluidicsModel() {
+        detach();
+    }
+
+    void attach() {
+        NativeHAL::setPinLevel(pin, HIGH);
+        listener = NativeHAL::addTimeListener(
+            [this](uint64_t from, uint64_t to) { step(from, to); });
+    }
+
+    void detach() {
+        if (listener >= 0) {
+            NativeHAL::removeTimeListener(listener);
+            listener = -1;
+        }
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Elapsed micros of the next turbine pulse, or 0 if there is no flow
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    uint64_t nextEventMicros() const {
+        return nextPulse;
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Output state of the shift register chain as of the last latch
+     *
+     *  @param number Pin number (ex: TPICDevices::FLUSH_VALVE or valve id + 8)
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    static bool output(int number) {
+        const auto & latched = NativeHAL::shiftRegister().latched;
+        const int index      = int(latched.size()) - 1 - number / 8;
+        return index >= 0 && (latched[index] >> (number % 8)) & 1;
+    }
+
+    // Open sample valve or -1. With several valves open, the lowest one wins.
+    int openValve() const {
+        for (int valve = 0; valve < ProgramSettings::MAX_VALVES; valve++) {
+            if (output(valve + firstValvePin)) {
+                return valve;
+            }
+        }
+
+        return -1;
+    }
+
+    // Inverse of the transfer function in TurbineFlowSensor (36.6-917 Hz ~ 0.110-2.476 lpm)
+    static double turbineHz(double lpm) {
+        if (lpm < 0.110) {
+            return 0;
+        }
+
+        return 37 + (lpm - 0.110) * (917 - 37) / (2.476 - 0.110);
+    }
+
+private:
+    void step(uint64_t from, uint64_t to) {
+        const double dt = (to - from) / 1e6;
+        moveIntake(dt);
+
+        // Water only reaches the manifold when the intake is fully open and the pump pushes
+        // forward. Reverse (offshoot clean), air and alcohol do not pass through the turbine.
+        const bool forward = NativeHAL::pinLevel(HardwarePins::MOTOR_FORWARD)
+                             && !NativeHAL::pinLevel(HardwarePins::MOTOR_REVERSE);
+        const bool water = forward && intakePosition >= 1
+                           && !output(TPICDevices::AIR_VALVE)
+                           && !output(TPICDevices::ALCHOHOL_VALVE);
+
+        const int valve = openValve();
+        if (water && output(TPICDevices::FLUSH_VALVE)) {
+            pressure = parameters.flushPressure;
+            lpm      = parameters.flushLpm;
+        } else if (water && valve >= 0) {
+            pressure = parameters.basePressure
+                       + parameters.clogPsiPerLiter * filteredLiters[valve];
+            pressure = std::min(pressure, parameters.pumpMaxPressure);
+            lpm      = parameters.sampleLpm * (1 - pressure / parameters.pumpMaxPressure);
+            filteredLiters[valve] += lpm * dt / 60;
+        } else {
+            pressure = 0;
+            lpm      = 0;
+        }
+
+        totals.waterLiters += lpm * dt / 60;
+        pressureSensor.pressure = pressure;
+        pulse(dt, to);
+    }
+
+    void moveIntake(double dt) {
+        const bool positive = output(TPICDevices::INTAKE_POS);
+        const bool negative = output(TPICDevices::INTAKE_NEG);
+        const float travel  = dt / parameters.intakeTravelSeconds;
+        if (positive && !negative) {
+            intakePosition = std::min(1.0f, intakePosition + travel);
+        } else if (negative && !positive) {
+            intakePosition = std::max(0.0f, intakePosition - travel);
+        }
+    }
+
+    void pulse(double dt, uint64_t to) {
+        const double hz = turbineHz(lpm);
+        if (hz == 0) {
+            pulsePhase = 0;
+            nextPulse  = 0;
+            return;
+        }
+
+        pulsePhase += hz * dt;
+        if (pulsePhase >= 1) {
+            pulsePhase = std::fmod(pulsePhase, 1.0);
+            totals.pulses++;
+            NativeHAL::setPinLevel(pin, LOW);
+            NativeHAL::setPinLevel(pin, HIGH);
+        }
+
+        nextPulse = to + uint64_t(std::ceil((1 - pulsePhase) / hz * 1e6));
+    }
+};
@@ -0,0 +1,122 @@
+#pragma once
+#include <KPState.hpp>
+#include <KPStateMachine.hpp>
+#include <NativeHAL.hpp>
+
+#include <Application/App.hpp>
+#include <States/Shared.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S T A G E   R E C O R D E R : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Observes the task state controllers and records, in virtual time, how long each stage
+// lasted, why each Sample stage ended and how long a full cycle took for each valve.
+//
+class StageRecorder : public KPStateMachineObserver {
+public:
+    struct Duration {
+        double total        = 0;
+        double min          = 0;
+        double max          = 0;
+        unsigned long count = 0;
+
+        void add(double seconds) {
+            min = count ? std::min(min, seconds) : seconds;
+            max = count ? std::max(max, seconds) : seconds;
+            total += seconds;
+            count++;
+        }
+    };
+
+    struct SampleResult {
+        int valve = -1;
+        std::string condition;  // volume, pressure or time
+        double seconds        = 0;
+        double measuredLiters = 0;  // what TurbineFlowSensor reported
+    };
+
+    struct Cycle {
+        int valve      = -1;
+        double seconds = 0;
+    };
+
+    std::map<std::string, Duration> stages;
+    std::vector<SampleResult> samples;
+    std::vector<Cycle> cycles;
+
+private:
+    App & app;
+    const KPState * current = nullptr;
+    uint64_t stageStart     = 0;
+    uint64_t cycleStart     = 0;
+    int cycleValve          = -1;
+
+    const char * KPStateMachineObserverName() const override {
+        return "Simulation-StageRecorder Observer";
+    }
+
+    static bool is(const KPState * state, const char * name) {
+        return state && strcmp(state->getName(), name) == 0;
+    }
+
+    void stateDidBegin(const KPState * next) override {
+        const uint64_t time = NativeHAL::elapsedMicros();
+        if (current) {
+            const double seconds = (time - stageStart) / 1e6;
+            stages[current->getName()].add(seconds);
+
+            if (is(current, Pipeline::SAMPLE)) {
+                auto sample = static_cast<const SharedStates::Sample *>(current);
+                samples.push_back({cycleValve, sample->condition ? sample->condition : "none",
+                                   seconds, app.sensors.flow.volume});
+            }
+        }
+
+        // Both controllers share the state names, so one check covers regular and now tasks.
+        // A cycle starts with the first stage of the pipeline, whichever it is.
+        if (cycleValve < 0 && !is(next, Pipeline::IDLE) && !is(next, Pipeline::STOP)) {
+            cycleStart = time;
+            cycleValve = app.status.currentValve;
+        }
+
+        if (is(next, Pipeline::IDLE) && cycleValve >= 0) {
+            cycles.push_back({cycleValve, (time - cycleStart) / 1e6});
+            cycleValve = -1;
+        }
+
+        current    = next;
+        stageStart = time;
+    }
+
+public:
+    StageRecorder(App & app) : app(app) {}
+
+    void print() const {
+        printf("\n%-24s %6s %10s %10s %10s\n", "stage", "count", "mean (s)", "min (s)",
+               "max (s)");
+        for (const auto & kv : stages) {
+            const Duration & d = kv.second;
+            printf("%-24s %6lu %10.2f %10.2f %10.2f\n", kv.first.c_str(), d.count,
+                   d.total / d.count, d.min, d.max);
+        }
+
+        printf("\n%-6s %-10s %10s %14s\n", "valve", "condition", "sample (s)", "measured (L)");
+        for (const auto & sample : samples) {
+            printf("%-6d %-10s %10.2f %14.3f\n", sample.valve, sample.condition.c_str(),
+                   sample.seconds, sample.measuredLiters);
+        }
+
+        printf("\n%-6s %10s\n", "valve", "cycle (s)");
+        for (const auto & cycle : cycles) {
+            printf("%-6d %10.2f\n", cycle.valve, cycle.seconds);
+        }
+    }
+};
@@ -0,0 +1,175 @@
+#include <Application/App.hpp>
+#include <DS3232RTC.h>
+#include <NativeHAL.hpp>
+#include <SD.h>
+#include <Devices/SamplerBoard.hpp>
+
+#include "FluidicsModel.hpp"
+#include "StageRecorder.hpp"
+
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//
+// ──────────────────────────────────────────────────────────────── I ──────────
+//   :::::: S A M P L I N G   D A Y : :  :   :    :     :        :          :
+// ──────────────────────────────────────────────────────────────────────────
+//
+// Replays a day of scheduled tasks plus one sample-now button press against FluidicsModel,
+// in virtual time. While the App has nothing to do, the simulation goes into standby and
+// wakes up on the next RTC alarm or button press, which is what the board does.
+//
+// Prints per-stage durations, why each sample ended and the full cycle time per valve.
+// Use `pio test -e native -f simulation`. NATIVE_VERBOSE=1 shows the firmware output.
+//
+
+namespace {
+    App app;
+
+    NativeHAL::SamplerBoard board;
+
+    FluidicsModel fluidics{board.pressureSensor};
+    StageRecorder recorder{app};
+
+    const int numberOfTasks        = 12;
+    const time_t taskInterval      = 2 * SECS_PER_HOUR;
+    const uint64_t loopMicros      = 1000;  // one App::update per ms of virtual time
+    const uint64_t simulatedMicros = uint64_t(SECS_PER_DAY) * 1000000;
+
+    // Button presses in elapsed micros. A press while the button is disabled is lost.
+    std::vector<uint64_t> buttonPresses;
+    size_t nextPress = 0;
+
+    void attachButton() {
+        NativeHAL::addTimeListener([](uint64_t from, uint64_t to) {
+            while (nextPress < buttonPresses.size() && buttonPresses[nextPress] <= to) {
+                NativeHAL::setPinLevel(HardwarePins::BUTTON_PIN, LOW);
+                NativeHAL::setPinLevel(HardwarePins::BUTTON_PIN, HIGH);
+                nextPress++;
+            }
+        });
+
+        NativeHAL::addWakeSource([]() -> uint64_t {
+            return nextPress < buttonPresses.size() ? buttonPresses[nextPress] : 0;
+        });
+    }
+
+    /** ────────────────────────────────────────────────────────────────────────────
+     *  @brief Run the App until `end` (elapsed micros). The clock steps to the next App
+     *  loop or turbine pulse, whichever comes first, so pulses land at their exact time.
+     *
+     *  @return false if the App went to sleep with nothing that could wake it up
+     *  ──────────────────────────────────────────────────────────────────────────── */
+    bool runUntil(uint64_t end) {
+        uint64_t nextLoop = NativeHAL::elapsedMicros();
+        for (uint64_t time = nextLoop; time < end; time = NativeHAL::elapsedMicros()) {
+            if (time >= nextLoop) {
+                app.update();
+                nextLoop = time + loopMicros;
+
+                // Same condition App::update uses to cut power outside of programming mode
+                if (!app.status.preventShutdown) {
+                    if (!NativeHAL::standby()) {
+                        return false;
+                    }
+
+                    nextLoop = 0;
+                    continue;
+                }
+            }
+
+            uint64_t target = std::min(nextLoop, end);
+            if (fluidics.nextEventMicros()) {
+                target = std::min(target, fluidics.nextEventMicros());
+            }
+
+            NativeHAL::advanceMicros(target > time ? target - time : 0);
+        }
+
+        return true;
+    }
+
+    void scheduleTasks(time_t start) {
+        for (int i = 0; i < numberOfTasks; i++) {
+            Task task = app.tm.createTask();
+            snprintf(task.name, sizeof(task.name), "sim-%d", i);
+            task.schedule     = start + 10 * SECS_PER_MIN + i * taskInterval;
+            task.timeBetween  = 5;
+            task.flushTime    = 10;
+            task.sampleTime   = 120;
+            task.dryTime      = 10;
+            task.preserveTime = 10;
+
+            // Rotate through the three ways a sample can end
+            task.sampleVolume   = i % 3 == 0 ? 0.5 : 100;
+            task.samplePressure = i % 3 == 1 ? 5 : 30;
+            task.valves.push_back(i);
+
+            app.tm.insertTask(task, true);
+            app.tm.setTaskStatus(task.id, TaskStatus::active);
+        }
+
+        app.tm.writeChangesToJournal();
+        app.scheduleNextActiveTask();
+    }
+}  // namespace
+
+// ─── TESTS ───────────────────────────────────────────────────────────────────
+
+void test_sampling_day() {
+    app.setup();
+    app.taskStateController.addObserver(recorder);
+    app.nowTaskStateController.addObserver(recorder);
+    fluidics.attach();
+
+    const uint64_t begin = NativeHAL::elapsedMicros();
+    scheduleTasks(now());
+
+    // Press the button between two scheduled tasks: the ones after it must still run, and the
+    // WiFi request of the press must be served once the now task is done
+    const time_t press = 10 * SECS_PER_MIN + (numberOfTasks / 2) * taskInterval + SECS_PER_HOUR;
+    buttonPresses.push_back(begin + uint64_t(press) * 1000000);
+    app.ntm.task.flushTime    = 10;
+    app.ntm.task.sampleTime   = 60;
+    app.ntm.task.dryTime      = 10;
+    app.ntm.task.preserveTime = 10;
+    app.ntm.task.valve        = numberOfTasks;
+    attachButton();
+
+    const auto wallStart = std::chrono::steady_clock::now();
+    runUntil(begin + simulatedMicros);
+    const double wallSeconds
+        = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    recorder.print();
+    printf("\nfiltered (L) per valve:");
+    for (int valve = 0; valve <= numberOfTasks; valve++) {
+        printf(" %.3f", fluidics.filteredLiters[valve]);
+    }
+
+    printf("\nturbine pulses: %lu, water: %.3f L\n", fluidics.totals.pulses,
+           fluidics.totals.waterLiters);
+    printf("simulated %.1f h in %.2f s\n",
+           (NativeHAL::elapsedMicros() - begin) / 3.6e9, wallSeconds);
+
+    TEST_ASSERT_EQUAL(numberOfTasks + 1, recorder.cycles.size());
+    TEST_ASSERT_EQUAL(numberOfTasks + 1, recorder.samples.size());
+    for (const auto & sample : recorder.samples) {
+        TEST_ASSERT_NOT_EQUAL(0, sample.condition.compare("none"));
+    }
+
+    TEST_ASSERT_FALSE(app.sampleNowActive);
+    TEST_ASSERT_FALSE(app.isRunningTask());
+    TEST_ASSERT_NULL(app.wifiRequested);
+    TEST_ASSERT_TRUE(app.wifiStarted);
+}
+
+int main(int argc, char ** argv) {
+    board.begin(HardwarePins::RTC_INTERRUPT, "sdcard_template");
+
+    UNITY_BEGIN();
+    RUN_TEST(test_sampling_day);
+    return UNITY_END();
+}